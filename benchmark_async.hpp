@@ -0,0 +1,452 @@
+#ifndef BENCHMARK_ASYNC_HPP
+#define BENCHMARK_ASYNC_HPP
+
+#include "benchmark.hpp"
+
+#include <coroutine>
+#include <future>
+
+/*
+ * Completion customization point for asynchronous returns
+ *
+ * Specialize with `static bool ready(T&)`, true once the operation has finished, and
+ * `static Value get(T&)` returning its value. std::future and std::shared_future are built in.
+ * A coroutine task type plugs in the same way, as long as it is already running somewhere
+ * (a thread pool, an io_uring loop) once the candidate returns it; EagerTask below is the
+ * smallest such type. Like ArgCopy, specializations go in the same (anonymous) namespace as
+ * the harness.
+ *
+ * Example, a task type with a completion flag:
+ * namespace {
+ * template<typename T> struct Completion<Task<T>>
+ * {
+ *   static bool ready(Task<T>& task) { return task.done(); }
+ *   static T get(Task<T>& task)      { return task.result(); }
+ * };
+ * }
+ */
+template<typename T>
+struct Completion {};
+
+template<typename T>
+struct Completion<std::future<T>>
+{
+  static bool ready(std::future<T>& future)
+  {
+    return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+  }
+
+  static T get(std::future<T>& future)
+  {
+    return future.get();
+  }
+};
+
+template<typename T>
+struct Completion<std::shared_future<T>>
+{
+  static bool ready(std::shared_future<T>& future)
+  {
+    return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+  }
+
+  static T get(std::shared_future<T>& future)
+  {
+    return future.get();
+  }
+};
+
+/*
+ * Minimal coroutine task that starts running as soon as it is called
+ *
+ * The body runs on the caller's thread up to its first suspension; whatever it co_awaits then
+ * resumes it, on any thread. done() turns true once the body has finished and the coroutine
+ * is parked at its final suspend point, so the owner can destroy it from another thread.
+ * Exceptions from the body are rethrown by result().
+ *
+ * Example:
+ * EagerTask<double> sum_on_pool(std::vector<double> x)
+ * {
+ *   co_await pool.schedule();
+ *   co_return std::accumulate(x.begin(), x.end(), 0.0);
+ * }
+ */
+template<typename T>
+class EagerTask
+{
+public:
+  struct promise_type
+  {
+    std::optional<T> value;
+    std::exception_ptr error;
+    std::atomic<bool> finished{false};
+
+    EagerTask get_return_object() { return EagerTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+
+    // Flags completion only once suspended, never while the body is still unwinding
+    auto final_suspend() noexcept
+    {
+      struct Finish
+      {
+        bool await_ready() noexcept { return false; }
+        void await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+        {
+          handle.promise().finished.store(true, std::memory_order_release);
+        }
+        void await_resume() noexcept {}
+      };
+      return Finish{};
+    }
+
+    void return_value(T result) { value.emplace(std::move(result)); }
+    void unhandled_exception() { error = std::current_exception(); }
+  };
+
+  EagerTask(EagerTask&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+  EagerTask& operator=(EagerTask&& other) noexcept
+  {
+    if (this != &other)
+    {
+      if (handle_) { handle_.destroy(); }
+      handle_ = std::exchange(other.handle_, nullptr);
+    }
+    return *this;
+  }
+
+  // Only destroy a finished task, an unfinished one is still referenced by whatever resumes it
+  ~EagerTask()
+  {
+    if (handle_) { handle_.destroy(); }
+  }
+
+  bool done() const
+  {
+    return handle_.promise().finished.load(std::memory_order_acquire);
+  }
+
+  T result()
+  {
+    if (handle_.promise().error) { std::rethrow_exception(handle_.promise().error); }
+    return std::move(*handle_.promise().value);
+  }
+
+private:
+  explicit EagerTask(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+  std::coroutine_handle<promise_type> handle_;
+};
+
+template<typename T>
+struct Completion<EagerTask<T>>
+{
+  static bool ready(EagerTask<T>& task)
+  {
+    return task.done();
+  }
+
+  static T get(EagerTask<T>& task)
+  {
+    return task.result();
+  }
+};
+
+// Returns the harness can poll for completion and that produce a value to check
+template<typename T>
+concept Awaitable = requires(T& pending)
+{
+  { Completion<T>::ready(pending) } -> std::convertible_to<bool>;
+  { Completion<T>::get(pending) };
+} && !std::is_void_v<decltype(Completion<T>::get(std::declval<T&>()))>;
+
+template<typename T>
+using awaited_t = std::decay_t<decltype(Completion<T>::get(std::declval<T&>()))>;
+
+/*
+ * Benchmark for candidates returning a future or awaitable
+ *
+ * Timing the call alone only measures submission, so every operation is timed from just before
+ * the call until the harness sees it complete. Completion is polled: the harness checks every
+ * slot in turn and yields when none has finished, so each latency sample also includes up to
+ * one polling pass plus a yield after the operation really finished. That delay matters for
+ * operations of a few microseconds or less, and grows with concurrency since a pass checks
+ * more slots. `concurrency` operations are kept in flight:
+ * whenever one completes the next is submitted into its slot, until `iter` have completed.
+ * Rows are measured one after another rather than interleaved, so operations of different
+ * candidates never compete for the same executor.
+ *
+ * Runtime is the mean completion latency and speedup is throughput relative to the baseline.
+ * print() adds ops/sec and latency percentiles; the error function compares awaited values,
+ * taken from the last operation to complete. Every operation gets its own copy of the
+ * arguments, but pointers are shared by operations in flight, so candidates mustn't write
+ * through them.
+ *
+ * Example:
+ * Benchmark<double, std::future<double>, std::vector<double>> bench(error,
+ *   [](std::vector<double> x) { return std::async(std::launch::async, sum, std::move(x)); },
+ *   1000, 8, input);
+ * bench.insert(pool_sum, "thread pool");
+ * bench.run();
+ * bench.print();
+ */
+template<typename Error, typename Return, typename... Args>
+  requires Awaitable<Return>
+class Benchmark<Error, Return, Args...> : public BenchmarkSimple<Error, awaited_t<Return>>
+{
+public:
+  using Value        = awaited_t<Return>;
+  using fn_benchmark = std::function<Return(Args...)>;
+  using typename BenchmarkSimple<Error, Value>::fn_error;
+  using typename BenchmarkSimple<Error, Value>::Result;
+  using Unique = typename BenchmarkRoot::Unique;
+
+  Benchmark(fn_error err, fn_benchmark bench, size_t iter, size_t concurrency, Args... args) :
+    BenchmarkSimple<Error, Value>(err, iter),
+    args_(std::move(args)...),
+    concurrency_(std::max<size_t>(concurrency, 1))
+  {
+    functions_.push_back(bench);
+    this->results_.push_back(make_row("Baseline"));
+    stats_.push_back(AsyncStats());
+    measure_row(0);
+  }
+
+  void insert(fn_benchmark function, const std::string& id)
+  {
+    if (this->has_ran) this->has_ran = false;
+    this->to_benchmark_ = (this->to_benchmark_ == 0)
+      ? functions_.size()
+      : this->to_benchmark_;
+
+    functions_.push_back(function);
+    this->results_.push_back(make_row(id));
+    stats_.push_back(AsyncStats());
+  }
+
+  // Row for `id` (the baseline is "Baseline"), nullptr if there is none
+  const Result* find(const std::string& id) const
+  {
+    for (const auto& result : this->results_)
+    {
+      if (result.data_.id == id) { return &result; }
+    }
+    return nullptr;
+  }
+
+  // Operations kept in flight. Baseline is re-measured and every candidate is marked stale
+  void set_concurrency(size_t concurrency)
+  {
+    concurrency_ = std::max<size_t>(concurrency, 1);
+    measure_row(0);
+
+    this->has_ran = false;
+    this->to_benchmark_ = (functions_.size() > 1) ? 1 : 0;
+  }
+
+  // Measures every candidate inserted since the last run
+  bool run()
+  {
+    if (this->to_benchmark_ == 0 || functions_.size() == 1) { return false; }
+    TraceScope trace("run");
+
+    if (this->reporter_)
+    {
+      this->reporter_->suite_start(this->name_, functions_.size() - this->to_benchmark_, this->iter_);
+    }
+    for (size_t j = this->to_benchmark_; j < functions_.size(); j++)
+    {
+      measure_row(j);
+    }
+    if (this->reporter_)
+    {
+      this->reporter_->suite_finish(this->name_);
+    }
+
+    this->to_benchmark_ = 0;
+    this->has_ran = true;
+    return true;
+  }
+
+  void print()
+  {
+    // Sort before display
+    this->sort();
+
+    std::cout << ">> " << this->name_ << " | Operations: " << this->iter_ << " | Concurrency: " << concurrency_
+              << " (timer: " << this->timer_.name() << ")\n";
+    std::cout << std::left << std::setw(32) << "ID"
+              << std::setw(14) << "Ops/sec"
+              << std::setw(14) << "Speedup"
+              << std::setw(14) << "Mean"
+              << std::setw(14) << "p50"
+              << std::setw(14) << "p90"
+              << std::setw(14) << "p99"
+              << std::setw(14) << "p99.9"
+              << std::setw(14) << "Max"
+              << std::setw(16) << "Result"
+              << std::setw(16) << "Error"
+              << '\n';
+    std::cout << std::string(172, '-') << '\n';
+
+    for (size_t j = 0; j < this->results_.size(); j++)
+    {
+      const auto& result = this->results_[j];
+      const auto& stats  = stats_[j];
+
+      std::ostringstream ops_str, speedup_str, result_str, error_str;
+      ops_str << std::scientific << std::setprecision(3) << stats.ops_per_sec;
+      speedup_str << std::fixed << std::setprecision(3) << result.data_.speedup << 'x'
+                  << (result.data_.noisy ? " !" : "");
+      result_str << std::fixed << std::setprecision(6) << result.result;
+      error_str << std::fixed << std::setprecision(6) << result.error;
+
+      std::cout << std::left << std::setw(32) << result.data_.id
+                << std::setw(14) << ops_str.str()
+                << std::setw(14) << speedup_str.str()
+                << std::setw(14) << this->format_runtime_string(result.data_.runtime)
+                << std::setw(14) << this->format_runtime_string(stats.p50)
+                << std::setw(14) << this->format_runtime_string(stats.p90)
+                << std::setw(14) << this->format_runtime_string(stats.p99)
+                << std::setw(14) << this->format_runtime_string(stats.p999)
+                << std::setw(14) << this->format_runtime_string(stats.max)
+                << std::setw(16) << result_str.str()
+                << std::setw(16) << error_str.str()
+                << '\n';
+    }
+  }
+
+private:
+  // Throughput and completion latency percentiles (ns) of one row
+  struct AsyncStats
+  {
+    double ops_per_sec{0.0};
+    double p50{0.0};
+    double p90{0.0};
+    double p99{0.0};
+    double p999{0.0};
+    double max{0.0};
+  };
+
+  std::vector<fn_benchmark> functions_;
+  std::tuple<Args...> args_;
+  size_t concurrency_;
+  std::vector<AsyncStats> stats_;       // Parallel to results_
+
+  static Result make_row(const std::string& id)
+  {
+    Result row;
+    row.data_ = (Unique)
+    {
+      .id      = id,
+      .runtime = 0.0,
+      .cycles  = 0.0,
+      .speedup = 1.0
+    };
+    row.result = Value();
+    row.error  = Error();
+    return row;
+  }
+
+  // Runs iter_ operations of row j with concurrency_ in flight and fills in its row
+  void measure_row(size_t j)
+  {
+    TraceScope trace("measure");
+
+    struct Slot
+    {
+      std::optional<Return> pending;
+      uint64_t start{0};
+    };
+    std::vector<Slot> slots(std::min(concurrency_, std::max<size_t>(this->iter_, 1)));
+
+    auto& data = this->results_[j].data_;
+    data.samples.assign(this->iter_, 0.0);
+
+    size_t submitted = 0, completed = 0;
+    std::optional<Value> last;
+
+    // Arguments are copied before the clock starts, the operation owns its copy
+    auto submit = [&](Slot& slot)
+    {
+      std::tuple<Args...> call_args = args_;
+      slot.start = this->timer_.start();
+      slot.pending.emplace(std::apply(functions_[j], std::move(call_args)));
+      submitted++;
+    };
+
+    const uint64_t wall_start = this->timer_.start();
+    for (auto& slot : slots)
+    {
+      if (submitted < this->iter_) { submit(slot); }
+    }
+
+    while (completed < this->iter_)
+    {
+      bool progressed = false;
+      for (auto& slot : slots)
+      {
+        if (!slot.pending || !Completion<Return>::ready(*slot.pending)) { continue; }
+
+        const uint64_t end = this->timer_.stop();
+        data.samples[completed++] = this->timer_.to_ns(static_cast<double>(end - slot.start));
+        last.emplace(Completion<Return>::get(*slot.pending));
+        slot.pending.reset();
+        progressed = true;
+
+        if (submitted < this->iter_) { submit(slot); }
+      }
+      // Leave the core to whatever completes the operations. An operation finishing meanwhile
+      // is only timed on the next pass, its sample includes the yield
+      if (!progressed) { std::this_thread::yield(); }
+    }
+    const uint64_t wall_end = this->timer_.stop();
+
+    // Latencies are summarized like any other samples, throughput comes from the wall time
+    this->summarize(data, this->noise_policy_);
+    data.cached = false;
+
+    std::vector<double> sorted = data.samples;
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&](double p)
+    {
+      return sorted.empty() ? 0.0 : sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()))];
+    };
+
+    const double wall_seconds = this->timer_.to_ns(static_cast<double>(wall_end - wall_start)) * 1e-9;
+    auto& stats = stats_[j];
+    stats.ops_per_sec = (wall_seconds > 0.0) ? this->iter_ / wall_seconds : 0.0;
+    stats.p50  = percentile(0.50);
+    stats.p90  = percentile(0.90);
+    stats.p99  = percentile(0.99);
+    stats.p999 = percentile(0.999);
+    stats.max  = sorted.empty() ? 0.0 : sorted.back();
+
+    auto& result = this->results_[j];
+    if (last) { result.result = std::move(*last); }
+    result.error = (j == 0) ? Error() : this->error_function_(this->results_[0].result, result.result);
+
+    // Baseline changes move every candidate's speedup with it
+    for (size_t k = 0; k < this->results_.size(); k++)
+    {
+      this->results_[k].data_.speedup = (stats_[0].ops_per_sec > 0.0)
+        ? static_cast<float>(stats_[k].ops_per_sec / stats_[0].ops_per_sec)
+        : 1.0f;
+    }
+
+    if (this->reporter_)
+    {
+      this->reporter_->candidate_finish(this->name_, this->make_report(data));
+    }
+  }
+
+  // Keep functions_ and stats_ aligned with results_ when sort() reorders the table
+  void swap_result_struct(size_t first, size_t second) override
+  {
+    BenchmarkSimple<Error, Value>::swap_result_struct(first, second);
+    std::swap(functions_[first], functions_[second]);
+    std::swap(stats_[first], stats_[second]);
+  }
+};
+
+#endif // BENCHMARK_ASYNC_HPP
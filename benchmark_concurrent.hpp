@@ -0,0 +1,419 @@
+#ifndef BENCHMARK_CONCURRENT_HPP
+#define BENCHMARK_CONCURRENT_HPP
+
+#include "benchmark.hpp"
+
+// Threads
+#include <atomic>
+#include <thread>
+#include <barrier>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <map>
+#include <stdexcept>
+
+/*
+ * Multi-producer/multi-consumer workloads over one shared state
+ *
+ * A factory builds fresh shared state for every thread mix. Each role (producer, consumer,
+ * reader, writer, ...) is an operation called in a loop by every thread assigned to it.
+ * An operation returns false when it did no work (pop on an empty queue) so failed attempts
+ * don't count as throughput. All threads are released together from a start barrier and
+ * run for a fixed wall time.
+ *
+ * Example:
+ * ConcurrentBenchmark<Queue> bench([]() { return std::make_unique<Queue>(); }, 200ms);
+ * bench.add_role("producer", [](Queue& q, size_t thread) { q.push(thread); return true; });
+ * bench.add_role("consumer", [](Queue& q, size_t)        { return q.try_pop(); });
+ * bench.add_mix("1p1c", {{"producer", 1}, {"consumer", 1}});
+ * bench.add_mix("4p4c", {{"producer", 4}, {"consumer", 4}});
+ */
+template<typename State>
+class ConcurrentBenchmark : public BenchmarkRoot
+{
+public:
+  using fn_factory   = std::function<std::unique_ptr<State>()>;
+  using fn_operation = std::function<bool(State&, size_t)>;
+  using Unique = typename BenchmarkRoot::Unique;
+
+  ConcurrentBenchmark(fn_factory factory, std::chrono::milliseconds duration,
+                      size_t max_samples_per_thread = 1 << 18) :
+    BenchmarkRoot(1),
+    factory_(factory),
+    duration_(duration),
+    max_samples_(max_samples_per_thread)
+  {}
+
+  void add_role(const std::string& role, fn_operation operation)
+  {
+    roles_[role] = operation;
+  }
+
+  // Thread counts per role, e.g. {{"producer", 2}, {"consumer", 6}}. The first mix is the baseline
+  void add_mix(const std::string& id, std::vector<std::pair<std::string, size_t>> threads)
+  {
+    if (this->has_ran) this->has_ran = false;
+
+    Mix mix;
+    mix.data_ = (Unique)
+    {
+      .id      = id,
+      .runtime = 0.0,
+      .cycles  = 0.0,
+      .speedup = 1.0
+    };
+    mix.threads = std::move(threads);
+    mixes_.push_back(mix);
+  }
+
+  // Results of one thread of a mix. Latencies are per op in ns
+  struct ThreadResult
+  {
+    std::string role;
+    size_t index;
+    size_t ops;
+    double ops_per_sec;
+    double mean;
+    double p50;
+    double p99;
+  };
+
+  // Results of one mix, latency statistics weigh every thread by the ops it completed
+  struct Mix
+  {
+    Unique data_;                                      // runtime holds mean per-op latency
+    std::vector<std::pair<std::string, size_t>> threads;
+    double ops_per_sec{0.0};
+    double p50{0.0};
+    double p99{0.0};
+    double p999{0.0};
+    double max{0.0};
+    double fairness{1.0};                              // Jain's index over per-thread throughput
+    std::vector<ThreadResult> per_thread;
+  };
+
+  // Measured mix by id, null if there is none
+  const Mix* find(const std::string& id) const
+  {
+    for (const auto& mix : mixes_)
+    {
+      if (mix.data_.id == id) { return &mix; }
+    }
+    return nullptr;
+  }
+
+  // Runs every mix that hasn't been measured yet. An operation that throws stops its mix, 
+  // the first exception is rethrown once every thread has been joined
+  bool run()
+  {
+    if (measured_ == mixes_.size()) { return false; }
+
+    for (size_t m = measured_; m < mixes_.size(); m++)
+    {
+      run_mix(mixes_[m]);
+    }
+    measured_ = mixes_.size();
+
+    // Speedup is throughput relative to the baseline mix
+    for (size_t m = 0; m < mixes_.size(); m++)
+    {
+      mixes_[m].data_.speedup = (mixes_[0].ops_per_sec > 0.0)
+        ? static_cast<float>(mixes_[m].ops_per_sec / mixes_[0].ops_per_sec)
+        : 1.0f;
+    }
+
+    this->has_ran = true;
+    return true;
+  }
+
+  void print()
+  {
+    // Sort before display
+    this->sort();
+
+    std::cout << ">> Duration: " << duration_.count() << " ms per mix (timer: " << this->timer_.name() << ")\n";
+    std::cout << std::left << std::setw(24) << "ID"
+              << std::setw(16) << "Ops/sec"
+              << std::setw(14) << "Speedup"
+              << std::setw(14) << "Mean"
+              << std::setw(14) << "p50"
+              << std::setw(14) << "p99"
+              << std::setw(14) << "p99.9"
+              << std::setw(14) << "Max"
+              << std::setw(10) << "Fairness"
+              << '\n';
+    std::cout << std::string(134, '-') << '\n';
+
+    for (const auto& mix : mixes_)
+    {
+      std::ostringstream ops_str, speedup_str, fairness_str;
+      ops_str << std::scientific << std::setprecision(3) << mix.ops_per_sec;
+      speedup_str << std::fixed << std::setprecision(3) << mix.data_.speedup << "x";
+      fairness_str << std::fixed << std::setprecision(3) << mix.fairness;
+
+      std::cout << std::left << std::setw(24) << mix.data_.id
+                << std::setw(16) << ops_str.str()
+                << std::setw(14) << speedup_str.str()
+                << std::setw(14) << format_runtime_string(mix.data_.runtime)
+                << std::setw(14) << format_runtime_string(mix.p50)
+                << std::setw(14) << format_runtime_string(mix.p99)
+                << std::setw(14) << format_runtime_string(mix.p999)
+                << std::setw(14) << format_runtime_string(mix.max)
+                << std::setw(10) << fairness_str.str()
+                << '\n';
+
+      // Per thread breakdown so starvation is visible
+      for (const auto& thread : mix.per_thread)
+      {
+        std::ostringstream thread_ops;
+        thread_ops << std::scientific << std::setprecision(3) << thread.ops_per_sec;
+        std::cout << "    " << std::left << std::setw(20) << (thread.role + "#" + std::to_string(thread.index))
+                  << std::setw(16) << thread_ops.str()
+                  << std::setw(14) << ""
+                  << std::setw(14) << format_runtime_string(thread.mean)
+                  << std::setw(14) << format_runtime_string(thread.p50)
+                  << std::setw(14) << format_runtime_string(thread.p99)
+                  << '\n';
+      }
+    }
+  }
+
+private:
+  fn_factory factory_;
+  std::chrono::milliseconds duration_;
+  size_t max_samples_;
+  std::map<std::string, fn_operation> roles_;
+  std::vector<Mix> mixes_;
+  size_t measured_{0};                                 // Mixes are measured in insertion order
+
+  // Per thread working storage. Latencies are raw timer ticks
+  struct Worker
+  {
+    std::string role;
+    size_t index;
+    fn_operation operation;
+    size_t ops{0};
+    uint64_t start{0};
+    uint64_t end{0};
+    std::vector<uint64_t> latencies;                   // Uniform reservoir over every op
+    std::mt19937_64 rng;
+    std::exception_ptr error;                          // Thrown by the operation, ends the mix
+  };
+
+  // A kept latency standing for `weight` ops of its thread
+  struct Weighted
+  {
+    uint64_t ticks;
+    double weight;
+  };
+
+  void run_mix(Mix& mix)
+  {
+    std::unique_ptr<State> state = factory_();
+
+    // Lay out workers, global thread index is passed to the operation
+    std::vector<Worker> workers;
+    for (const auto& [role, count] : mix.threads)
+    {
+      auto found = roles_.find(role);
+      if (found == roles_.end())
+      {
+        throw std::runtime_error("Unknown role in thread mix: " + role);
+      }
+      for (size_t t = 0; t < count; t++)
+      {
+        Worker worker;
+        worker.role      = role;
+        worker.index     = workers.size();
+        worker.operation = found->second;
+        worker.latencies.reserve(max_samples_);
+        worker.rng.seed(worker.index + 1);
+        workers.push_back(std::move(worker));
+      }
+    }
+    if (workers.empty()) { return; }
+
+    std::atomic<bool> stop{false};
+    std::mutex stop_mutex;
+    std::condition_variable stopped;
+    std::barrier start_barrier(static_cast<std::ptrdiff_t>(workers.size() + 1));
+    const Timer timer = this->timer_;
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers.size());
+    for (auto& worker : workers)
+    {
+      threads.emplace_back([&worker, &state, &stop, &stop_mutex, &stopped, &start_barrier, &timer, this]()
+      {
+        start_barrier.arrive_and_wait();
+
+        worker.start = timer.start();
+        while (!stop.load(std::memory_order_relaxed))
+        {
+          const uint64_t op_start = timer.start();
+          bool did_work = false;
+          try
+          {
+            did_work = worker.operation(*state, worker.index);
+          }
+          catch (...)
+          {
+            // Leaving the thread with it would terminate, end the mix and hand it to run()
+            worker.error = std::current_exception();
+            {
+              std::lock_guard<std::mutex> lock(stop_mutex);
+              stop.store(true, std::memory_order_relaxed);
+            }
+            stopped.notify_one();
+            break;
+          }
+          const uint64_t op_end = timer.stop();
+
+          if (!did_work) { continue; }
+          worker.ops++;
+          // Reservoir sampling keeps every op equally likely to be kept, so a long run
+          // isn't summarized by its warm-up
+          if (worker.latencies.size() < max_samples_)
+          {
+            worker.latencies.push_back(op_end - op_start);
+          }
+          else
+          {
+            const size_t slot = worker.rng() % worker.ops;
+            if (slot < max_samples_) { worker.latencies[slot] = op_end - op_start; }
+          }
+        }
+        worker.end = timer.stop();
+      });
+    }
+
+    // Release everyone at once, then let the mix run for the configured wall time or until 
+    // an operation throws
+    start_barrier.arrive_and_wait();
+    {
+      std::unique_lock<std::mutex> lock(stop_mutex);
+      stopped.wait_for(lock, duration_, [&]() { return stop.load(std::memory_order_relaxed); });
+      stop.store(true, std::memory_order_relaxed);
+    }
+
+    for (auto& thread : threads) { thread.join(); }
+
+    for (const auto& worker : workers)
+    {
+      if (worker.error) { std::rethrow_exception(worker.error); }
+    }
+    collect(mix, workers);
+  }
+
+  // Every thread keeps at most max_samples_ latencies however many ops it ran, so a kept 
+  // sample stands for ops / kept ops of its thread in the mix-wide statistics
+  void collect(Mix& mix, std::vector<Worker>& workers)
+  {
+    std::vector<Weighted> all_latencies;
+    size_t total_ops = 0;
+    uint64_t earliest = UINT64_MAX, latest = 0;
+    double sum_rates = 0.0, sum_rates_squared = 0.0;
+
+    mix.per_thread.clear();
+    for (auto& worker : workers)
+    {
+      total_ops += worker.ops;
+      earliest = std::min(earliest, worker.start);
+      latest   = std::max(latest, worker.end);
+
+      const double seconds = this->timer_.to_ns(static_cast<double>(worker.end - worker.start)) * 1e-9;
+      const double rate = (seconds > 0.0) ? worker.ops / seconds : 0.0;
+      sum_rates += rate;
+      sum_rates_squared += rate * rate;
+
+      std::sort(worker.latencies.begin(), worker.latencies.end());
+      ThreadResult result;
+      result.role        = worker.role;
+      result.index       = worker.index;
+      result.ops         = worker.ops;
+      result.ops_per_sec = rate;
+      result.mean        = this->timer_.to_ns(mean_ticks(worker.latencies));
+      result.p50         = percentile_ns(worker.latencies, 0.50);
+      result.p99         = percentile_ns(worker.latencies, 0.99);
+      mix.per_thread.push_back(result);
+
+      const double weight = worker.latencies.empty() 
+        ? 0.0 
+        : static_cast<double>(worker.ops) / static_cast<double>(worker.latencies.size());
+      for (uint64_t ticks : worker.latencies) { all_latencies.push_back({ ticks, weight }); }
+    }
+
+    std::sort(all_latencies.begin(), all_latencies.end(), 
+      [](const Weighted& a, const Weighted& b) { return a.ticks < b.ticks; });
+
+    double total_weight = 0.0, weighted_ticks = 0.0;
+    for (const auto& sample : all_latencies)
+    {
+      total_weight   += sample.weight;
+      weighted_ticks += sample.weight * static_cast<double>(sample.ticks);
+    }
+    const double mean = (total_weight > 0.0) ? weighted_ticks / total_weight : 0.0;
+
+    const double wall_seconds = this->timer_.to_ns(static_cast<double>(latest - earliest)) * 1e-9;
+    mix.ops_per_sec   = (wall_seconds > 0.0) ? total_ops / wall_seconds : 0.0;
+    mix.data_.runtime = this->timer_.to_ns(mean);
+    mix.data_.cycles  = (this->timer_.backend() == TimerBackend::TSC) ? mean : 0.0;
+    mix.p50  = weighted_percentile_ns(all_latencies, total_weight, 0.50);
+    mix.p99  = weighted_percentile_ns(all_latencies, total_weight, 0.99);
+    mix.p999 = weighted_percentile_ns(all_latencies, total_weight, 0.999);
+    mix.max  = all_latencies.empty() ? 0.0 : this->timer_.to_ns(static_cast<double>(all_latencies.back().ticks));
+
+    // Jain's fairness: 1 when every thread gets equal throughput, 1/n when one thread gets it all
+    const double n = static_cast<double>(workers.size());
+    mix.fairness = (sum_rates_squared > 0.0) ? (sum_rates * sum_rates) / (n * sum_rates_squared) : 1.0;
+  }
+
+  static double mean_ticks(const std::vector<uint64_t>& latencies)
+  {
+    if (latencies.empty()) { return 0.0; }
+    double sum = 0.0;
+    for (uint64_t ticks : latencies) { sum += static_cast<double>(ticks); }
+    return sum / latencies.size();
+  }
+
+  // Nearest rank percentile of an already sorted sample
+  double percentile_ns(const std::vector<uint64_t>& sorted, double p) const
+  {
+    if (sorted.empty()) { return 0.0; }
+    const size_t rank = std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()));
+    return this->timer_.to_ns(static_cast<double>(sorted[rank]));
+  }
+
+  // Smallest latency whose cumulative weight passes p of the total, the weighted nearest rank
+  double weighted_percentile_ns(const std::vector<Weighted>& sorted, double total_weight, double p) const
+  {
+    if (sorted.empty()) { return 0.0; }
+    const double target = p * total_weight;
+    double cumulative = 0.0;
+    for (const auto& sample : sorted)
+    {
+      cumulative += sample.weight;
+      if (cumulative > target) { return this->timer_.to_ns(static_cast<double>(sample.ticks)); }
+    }
+    return this->timer_.to_ns(static_cast<double>(sorted.back().ticks));
+  }
+
+  // Implementation of virtual methods for sort
+  size_t get_result_count() const override
+  {
+    return mixes_.size();
+  }
+
+  Unique& get_unique_struct(size_t index) const override
+  {
+    return const_cast<Unique&>(mixes_[index].data_);
+  }
+
+  void swap_result_struct(size_t first, size_t second) override
+  {
+    std::swap(mixes_[first], mixes_[second]);
+  }
+};
+
+#endif // BENCHMARK_CONCURRENT_HPP
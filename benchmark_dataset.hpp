@@ -0,0 +1,257 @@
+#ifndef BENCHMARK_DATASET_HPP
+#define BENCHMARK_DATASET_HPP
+
+#include "benchmark.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+/*
+ * Binary datasets for very large benchmark inputs
+ *
+ * write_dataset() fills a file from a seeded generator in fixed size chunks, each chunk with
+ * its own generator derived from (seed, chunk), so the contents are identical whatever the
+ * thread count or standard library. Dataset<T> maps a file read-only: data()/size() feed a
+ * (const T*, count) pair and span() a std::span<const T>, both passed to every call without
+ * a copy. mutable_span() hands out a copy-on-write view for kernels that write their input.
+ * Pair it with RestoreStrategy::DirtyPages, which maps the file privately again instead of
+ * copying the view and restores the pages each call wrote from the read-only mapping; the
+ * default deep copy copies the whole span every iteration.
+ *
+ * File layout: one page of header, then the elements, page aligned.
+ *
+ * Example:
+ * write_dataset<float>("x.bin", 1'000'000'000, 42, [](DatasetRng& rng) { return rng.uniform(0.0, 1.0); });
+ * Dataset<float> x("x.bin");
+ * Benchmark<float, float, const float*, size_t> bench(error, sum_wrapper, 10, x.data(), x.size());
+ */
+
+// splitmix64, small and fast enough for billions of elements and fully specified
+class DatasetRng
+{
+public:
+  explicit DatasetRng(uint64_t seed) : state_(seed) {}
+
+  uint64_t next()
+  {
+    uint64_t z = (state_ += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+  }
+
+  // [0, 1) with 53 bits of randomness
+  double unit()
+  {
+    return static_cast<double>(next() >> 11) * 0x1.0p-53;
+  }
+
+  double uniform(double min, double max)
+  {
+    return min + (max - min) * unit();
+  }
+
+  // Box-Muller, one draw per call so the stream doesn't depend on call pairing
+  double normal(double mean, double stddev)
+  {
+    const double u1 = 1.0 - unit();
+    const double u2 = unit();
+    return mean + stddev * std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * M_PI * u2);
+  }
+
+private:
+  uint64_t state_;
+};
+
+struct DatasetHeader
+{
+  char magic[8];            // "BMKDATA"
+  uint32_t version;
+  uint32_t element_size;
+  char type[16];            // dataset_type<T>(), checked on load
+  uint64_t count;
+  uint64_t seed;
+  uint64_t data_offset;
+};
+
+inline constexpr uint64_t dataset_data_offset = 4096;
+inline constexpr size_t dataset_chunk = size_t(1) << 20;
+
+// Type tag stored in the header
+template<typename T>
+std::string dataset_type()
+{
+  if constexpr (std::is_same_v<T, float>)         { return "float"; }
+  else if constexpr (std::is_same_v<T, double>)   { return "double"; }
+  else if constexpr (std::is_integral_v<T>)
+  {
+    return (std::is_signed_v<T> ? "int" : "uint") + std::to_string(sizeof(T) * 8);
+  }
+  else
+  {
+    return "bytes" + std::to_string(sizeof(T));
+  }
+}
+
+// Writes `count` elements from `generate(DatasetRng&)` to `path` using `threads` writers
+template<typename T, typename Generator>
+bool write_dataset(const std::string& path, uint64_t count, uint64_t seed, Generator generate,
+                   unsigned threads = std::thread::hardware_concurrency())
+{
+  static_assert(std::is_trivially_copyable_v<T>, "Dataset elements are written as raw bytes");
+
+  const int fd = open(path.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+  if (fd < 0) { return false; }
+
+  DatasetHeader header = {};
+  std::memcpy(header.magic, "BMKDATA", 8);
+  header.version      = 1;
+  header.element_size = sizeof(T);
+  std::strncpy(header.type, dataset_type<T>().c_str(), sizeof(header.type) - 1);
+  header.count        = count;
+  header.seed         = seed;
+  header.data_offset  = dataset_data_offset;
+
+  const bool ok = pwrite(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header))
+    && ftruncate(fd, static_cast<off_t>(dataset_data_offset + count * sizeof(T))) == 0;
+
+  // Chunks are claimed dynamically, each seeded from (seed, chunk) alone
+  const uint64_t chunks = (count + dataset_chunk - 1) / dataset_chunk;
+  std::atomic<uint64_t> next_chunk{0};
+  std::atomic<bool> failed{!ok};
+
+  auto writer = [&]()
+  {
+    std::vector<T> buffer(dataset_chunk);
+    for (uint64_t chunk = next_chunk++; chunk < chunks && !failed; chunk = next_chunk++)
+    {
+      DatasetRng rng(DatasetRng(seed ^ (chunk * 0xd1b54a32d192ed03ull)).next());
+      const uint64_t first = chunk * dataset_chunk;
+      const size_t n = static_cast<size_t>(std::min<uint64_t>(dataset_chunk, count - first));
+      for (size_t i = 0; i < n; i++) { buffer[i] = static_cast<T>(generate(rng)); }
+
+      const size_t bytes = n * sizeof(T);
+      const off_t offset = static_cast<off_t>(dataset_data_offset + first * sizeof(T));
+      for (size_t written = 0; written < bytes; )
+      {
+        const ssize_t result = pwrite(fd, reinterpret_cast<const char*>(buffer.data()) + written,
+                                      bytes - written, offset + static_cast<off_t>(written));
+        if (result <= 0)
+        {
+          failed = true;
+          break;
+        }
+        written += static_cast<size_t>(result);
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  const unsigned n_threads = static_cast<unsigned>(std::clamp<uint64_t>(std::max(threads, 1u), 1, std::max<uint64_t>(chunks, 1)));
+  for (unsigned t = 1; t < n_threads; t++) { workers.emplace_back(writer); }
+  writer();
+  for (auto& worker : workers) { worker.join(); }
+
+  // Close even after a failed write, a late write error can surface here
+  const bool closed = close(fd) == 0;
+  return !failed && closed;
+}
+
+// Read-only mapping of a dataset file. Throws std::runtime_error when the file is missing,
+// truncated or holds a different element type
+template<typename T>
+class Dataset
+{
+public:
+  explicit Dataset(const std::string& path)
+  {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) { throw std::runtime_error("Dataset: cannot open " + path); }
+
+    struct stat info = {};
+    DatasetHeader header = {};
+    if (fstat(fd, &info) != 0 || pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))
+        || std::memcmp(header.magic, "BMKDATA", 8) != 0)
+    {
+      close(fd);
+      throw std::runtime_error("Dataset: " + path + " is not a dataset file");
+    }
+    if (header.element_size != sizeof(T) || std::string(header.type, strnlen(header.type, sizeof(header.type))) != dataset_type<T>())
+    {
+      close(fd);
+      throw std::runtime_error("Dataset: " + path + " holds " + std::string(header.type, strnlen(header.type, sizeof(header.type)))
+                               + ", not " + dataset_type<T>());
+    }
+    if (static_cast<uint64_t>(info.st_size) < header.data_offset + header.count * sizeof(T))
+    {
+      close(fd);
+      throw std::runtime_error("Dataset: " + path + " is truncated");
+    }
+
+    count_ = header.count;
+    seed_  = header.seed;
+    offset_ = header.data_offset;
+    bytes_ = static_cast<size_t>(header.data_offset + header.count * sizeof(T));
+
+    mapping_ = mmap(nullptr, bytes_, PROT_READ, MAP_SHARED, fd, 0);
+    fd_ = fd;
+    if (mapping_ == MAP_FAILED)
+    {
+      close(fd);
+      throw std::runtime_error("Dataset: mmap failed for " + path);
+    }
+    // Inputs are usually streamed front to back
+    madvise(mapping_, bytes_, MADV_SEQUENTIAL);
+  }
+
+  ~Dataset()
+  {
+    for (auto& [view, bytes] : views_)
+    {
+      FileBackedViews::remove(static_cast<char*>(view) + offset_);
+      munmap(view, bytes);
+    }
+    if (mapping_ != MAP_FAILED) { munmap(mapping_, bytes_); }
+    if (fd_ >= 0) { close(fd_); }
+  }
+
+  Dataset(const Dataset&) = delete;
+  Dataset& operator=(const Dataset&) = delete;
+
+  const T* data() const { return reinterpret_cast<const T*>(static_cast<const char*>(mapping_) + offset_); }
+  size_t size() const { return static_cast<size_t>(count_); }
+  uint64_t seed() const { return seed_; }
+
+  std::span<const T> span() const { return std::span<const T>(data(), size()); }
+
+  // Private copy-on-write view: writes stay in this process and never reach the file. Lives
+  // as long as the Dataset. Benchmark it with RestoreStrategy::DirtyPages, registered so the
+  // harness restores it from the file rather than a snapshot of its own
+  std::span<T> mutable_span()
+  {
+    void* view = mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd_, 0);
+    if (view == MAP_FAILED) { throw std::runtime_error("Dataset: private mapping failed"); }
+    views_.emplace_back(view, bytes_);
+
+    T* first = reinterpret_cast<T*>(static_cast<char*>(view) + offset_);
+    FileBackedViews::add({ first, size() * sizeof(T), fd_, offset_, data() });
+    return std::span<T>(first, size());
+  }
+
+  // Pre-faults the mapping so the first timed iterations don't pay for page cache misses
+  void prefetch() const
+  {
+    madvise(mapping_, bytes_, MADV_WILLNEED);
+  }
+
+private:
+  void* mapping_{MAP_FAILED};
+  int fd_{-1};
+  uint64_t count_{0};
+  uint64_t seed_{0};
+  uint64_t offset_{0};
+  size_t bytes_{0};
+  std::vector<std::pair<void*, size_t>> views_;
+};
+
+#endif // BENCHMARK_DATASET_HPP
@@ -0,0 +1,342 @@
+#ifndef BENCHMARK_TUNER_HPP
+#define BENCHMARK_TUNER_HPP
+
+#include "benchmark.hpp"
+
+#include <map>
+#include <random>
+#include <stdexcept>
+
+// Parameter name -> chosen value for one configuration
+using TuningConfig = std::map<std::string, long>;
+
+// One tunable knob. Values run from min to max inclusive, adding `step` or multiplying by it
+// when geometric (unroll 1, 2, 4, 8 ...)
+struct TunableParameter
+{
+  std::string name;
+  long min;
+  long max;
+  long step;
+  bool geometric;
+
+  std::vector<long> values() const
+  {
+    std::vector<long> result;
+    for (long value = min; value <= max; )
+    {
+      result.push_back(value);
+      const long next = geometric ? value * step : value + step;
+      if (next <= value) { break; }
+      value = next;
+    }
+    return result;
+  }
+};
+
+// Calls f(std::integral_constant<long, V>{}) for the V in Values matching `value`, so template
+// parameters (unroll factors, block sizes) can be driven from a TuningConfig.
+// dispatch<1, 2, 4, 8>(config.at("unroll"), [&](auto u) { return kernel<u.value>(x); });
+template<long First, long... Rest, typename F>
+auto dispatch(long value, F&& f)
+{
+  using R = decltype(f(std::integral_constant<long, First>{}));
+  std::optional<R> result;
+  (value == First ? (result.emplace(f(std::integral_constant<long, First>{})), true) : false)
+    || ((value == Rest ? (result.emplace(f(std::integral_constant<long, Rest>{})), true) : false) || ...);
+  if (!result)
+  {
+    throw std::runtime_error("dispatch: value " + std::to_string(value) + " was not instantiated");
+  }
+  return std::move(*result);
+}
+
+/*
+ * Searches a candidate's parameter space for the fastest configuration within an error budget
+ *
+ * The candidate takes a TuningConfig ahead of the benchmarked arguments. Every configuration is
+ * inserted into a Benchmark against the reference function, so runtimes, noise handling and
+ * the error function behave exactly as they do for hand written candidates.
+ *
+ * Example:
+ * Tuner<float, float, float> tuner(error, sqrt_wrapper,
+ *   [](const TuningConfig& c, float x) { return newton(x, c.at("iterations")); }, 100000, input);
+ * tuner.add_parameter("iterations", 1, 20);
+ * tuner.set_error_budget(1e-4);
+ * tuner.tune(Tuner<float, float, float>::Strategy::Grid);
+ */
+template<typename Error, typename Return, typename... Args>
+class Tuner
+{
+public:
+  using fn_error     = std::function<Error(Return, Return)>;
+  using fn_benchmark = std::function<Return(Args...)>;
+  using fn_candidate = std::function<Return(const TuningConfig&, Args...)>;
+
+  enum class Strategy
+  {
+    Grid,                 // Every combination, max_configs must be 0
+    Random,               // max_configs (required) combinations drawn without replacement
+    SuccessiveHalving     // Cheap round over everything (or a random max_configs of it), then double
+                          // iterations for the best half
+  };
+
+  Tuner(fn_error err, fn_benchmark reference, fn_candidate candidate, size_t iter, Args... args) :
+    error_function_(err),
+    reference_(reference),
+    candidate_(candidate),
+    iter_(iter),
+    args_(args...)
+  {
+    if constexpr (std::is_convertible_v<Error, double>)
+    {
+      error_magnitude_ = [](const Error& e) { return std::abs(static_cast<double>(e)); };
+    }
+  }
+
+  void add_parameter(const std::string& name, long min, long max, long step = 1, bool geometric = false)
+  {
+    parameters_.push_back({ name, min, max, step, geometric });
+  }
+
+  // Largest acceptable |error| against the reference. Negative means unlimited
+  void set_error_budget(double budget)
+  {
+    error_budget_ = budget;
+  }
+
+  // Needed when Error isn't convertible to double
+  void set_error_magnitude(std::function<double(const Error&)> magnitude)
+  {
+    error_magnitude_ = magnitude;
+  }
+
+  // Runs the search and returns the fastest configuration within budget (empty if none is).
+  // Throws when Random has no max_configs, when Grid is given one, or when an error budget is
+  // set but Error has no magnitude to compare against it
+  TuningConfig tune(Strategy strategy, size_t max_configs = 0, uint64_t seed = 0)
+  {
+    if (strategy == Strategy::Random && max_configs == 0)
+    {
+      throw std::invalid_argument("tune: Strategy::Random needs max_configs");
+    }
+    if (strategy == Strategy::Grid && max_configs != 0)
+    {
+      throw std::invalid_argument("tune: Strategy::Grid evaluates every combination, use Random to sample max_configs");
+    }
+    if (error_budget_ >= 0.0 && !error_magnitude_)
+    {
+      throw std::runtime_error("tune: Error isn't convertible to double, call set_error_magnitude() to use an error budget");
+    }
+
+    trials_.clear();
+    std::vector<TuningConfig> configs = enumerate();
+
+    if (max_configs != 0)
+    {
+      std::mt19937_64 rng(seed);
+      std::shuffle(configs.begin(), configs.end(), rng);
+      if (configs.size() > max_configs) { configs.resize(max_configs); }
+    }
+
+    if (strategy == Strategy::SuccessiveHalving)
+    {
+      // Start cheap enough that the first round costs about one full measurement per config
+      size_t iter = std::max<size_t>(1, iter_ >> static_cast<size_t>(std::log2(std::max<size_t>(configs.size(), 1))));
+      size_t round = 0;
+      while (!configs.empty())
+      {
+        std::vector<Trial> trials = evaluate(configs, iter, "Tuning round " + std::to_string(round++));
+
+        // Over budget configurations drop out immediately, the faster half moves on
+        std::vector<Trial> survivors;
+        for (const auto& trial : trials)
+        {
+          if (trial.within_budget) { survivors.push_back(trial); }
+        }
+        std::sort(survivors.begin(), survivors.end(),
+          [](const Trial& a, const Trial& b) { return a.runtime < b.runtime; });
+
+        record(trials);
+        if (survivors.size() <= 1 || iter >= iter_) { break; }
+
+        survivors.resize((survivors.size() + 1) / 2);
+        configs.clear();
+        for (const auto& trial : survivors) { configs.push_back(trial.config); }
+        iter = std::min(iter_, iter * 2);
+      }
+    }
+    else
+    {
+      record(evaluate(configs, iter_, "Tuning"));
+    }
+
+    return best().config;
+  }
+
+  // Configurations the last tune() measured
+  size_t evaluated() const
+  {
+    return trials_.size();
+  }
+
+  // Every configuration evaluated, fastest first, best within budget marked
+  void print() const
+  {
+    std::vector<Trial> sorted = trials_;
+    std::sort(sorted.begin(), sorted.end(),
+      [](const Trial& a, const Trial& b) { return a.runtime < b.runtime; });
+    const Trial top = best();
+
+    std::cout << ">> Tuning: " << trials_.size() << " configurations, error budget ";
+    if (error_budget_ < 0.0) { std::cout << "unlimited\n"; }
+    else                     { std::cout << error_budget_ << '\n'; }
+
+    std::cout << std::left << std::setw(40) << "Configuration"
+              << std::setw(16) << "Runtime"
+              << std::setw(12) << "Iterations"
+              << std::setw(16) << "Speedup"
+              << std::setw(16) << "|Error|"
+              << '\n';
+    std::cout << std::string(100, '-') << '\n';
+
+    for (const auto& trial : sorted)
+    {
+      std::ostringstream runtime_str, speedup_str, error_str;
+      runtime_str << std::fixed << std::setprecision(4) << trial.runtime << " ns";
+      speedup_str << std::fixed << std::setprecision(4) << trial.speedup << "x fast";
+      error_str   << std::scientific << std::setprecision(3) << trial.error
+                  << (trial.within_budget ? "" : " (over)");
+
+      const bool is_best = !top.id.empty() && trial.id == top.id && trial.iterations == top.iterations;
+      std::cout << std::left << std::setw(40) << ((is_best ? "* " : "  ") + trial.id)
+                << std::setw(16) << runtime_str.str()
+                << std::setw(12) << trial.iterations
+                << std::setw(16) << speedup_str.str()
+                << std::setw(16) << error_str.str()
+                << '\n';
+    }
+  }
+
+  static std::string describe(const TuningConfig& config)
+  {
+    std::ostringstream ss;
+    bool first = true;
+    for (const auto& [name, value] : config)
+    {
+      ss << (first ? "" : " ") << name << '=' << value;
+      first = false;
+    }
+    return ss.str();
+  }
+
+private:
+  struct Trial
+  {
+    TuningConfig config;
+    std::string id;
+    size_t iterations;
+    double runtime;
+    double speedup;
+    double error;
+    bool within_budget;
+  };
+
+  fn_error error_function_;
+  fn_benchmark reference_;
+  fn_candidate candidate_;
+  size_t iter_;
+  std::tuple<Args...> args_;
+  std::vector<TunableParameter> parameters_;
+  double error_budget_{-1.0};
+  std::function<double(const Error&)> error_magnitude_;
+  std::vector<Trial> trials_;
+
+  // Cartesian product of every parameter's values
+  std::vector<TuningConfig> enumerate() const
+  {
+    std::vector<TuningConfig> configs(1);
+    for (const auto& parameter : parameters_)
+    {
+      std::vector<TuningConfig> expanded;
+      for (const auto& config : configs)
+      {
+        for (long value : parameter.values())
+        {
+          TuningConfig next = config;
+          next[parameter.name] = value;
+          expanded.push_back(next);
+        }
+      }
+      configs = std::move(expanded);
+    }
+    return configs;
+  }
+
+  // One Benchmark per round so every configuration shares a baseline measured alongside it
+  std::vector<Trial> evaluate(const std::vector<TuningConfig>& configs, size_t iter, const std::string& name)
+  {
+    auto bench = std::apply([&](const auto&... args)
+    {
+      return std::make_unique<Benchmark<Error, Return, Args...>>(error_function_, reference_, iter, args...);
+    }, args_);
+    bench->set_name(name);
+
+    for (const auto& config : configs)
+    {
+      fn_candidate candidate = candidate_;
+      bench->insert([candidate, config](Args... args) { return candidate(config, args...); }, describe(config));
+    }
+    bench->run();
+
+    std::vector<Trial> trials;
+    for (const auto& config : configs)
+    {
+      const auto* row = bench->find(describe(config));
+      if (row == nullptr) { continue; }
+
+      Trial trial;
+      trial.config        = config;
+      trial.id            = describe(config);
+      trial.iterations    = iter;
+      trial.runtime       = row->data_.runtime;
+      trial.speedup       = row->data_.speedup;
+      trial.error         = error_magnitude_ ? error_magnitude_(row->error) : 0.0;
+      trial.within_budget = error_budget_ < 0.0 || trial.error <= error_budget_;
+      trials.push_back(trial);
+    }
+    return trials;
+  }
+
+  // Later (longer) rounds replace earlier measurements of the same configuration
+  void record(const std::vector<Trial>& trials)
+  {
+    for (const auto& trial : trials)
+    {
+      auto found = std::find_if(trials_.begin(), trials_.end(),
+        [&](const Trial& t) { return t.id == trial.id; });
+      if (found != trials_.end()) { *found = trial; }
+      else                        { trials_.push_back(trial); }
+    }
+  }
+
+  Trial best() const
+  {
+    Trial top{};
+    bool found = false;
+    for (const auto& trial : trials_)
+    {
+      // Prefer the most thoroughly measured configurations, then the fastest
+      if (!trial.within_budget) { continue; }
+      if (!found || trial.iterations > top.iterations
+          || (trial.iterations == top.iterations && trial.runtime < top.runtime))
+      {
+        top = trial;
+        found = true;
+      }
+    }
+    return top;
+  }
+};
+
+#endif // BENCHMARK_TUNER_HPP
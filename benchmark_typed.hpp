@@ -0,0 +1,242 @@
+#ifndef BENCHMARK_TYPED_HPP
+#define BENCHMARK_TYPED_HPP
+
+#include "benchmark.hpp"
+
+#include <cxxabi.h>
+#include <typeinfo>
+
+// Compile time list of element types a family is instantiated over
+template<typename... Ts>
+struct TypeList {};
+
+// Short readable name for column headers. Fixed width integers and floating point types get
+// their usual short names, everything else (custom PODs) is demangled
+template<typename T>
+std::string type_name()
+{
+  if constexpr (std::is_same_v<T, bool>)          { return "bool"; }
+  else if constexpr (std::is_same_v<T, char>)     { return "char"; }
+  else if constexpr (std::is_same_v<T, float>)    { return "float"; }
+  else if constexpr (std::is_same_v<T, double>)   { return "double"; }
+  else if constexpr (std::is_same_v<T, long double>) { return "long double"; }
+  else if constexpr (std::is_integral_v<T>)
+  {
+    return (std::is_signed_v<T> ? "int" : "uint") + std::to_string(sizeof(T) * 8);
+  }
+  else
+  {
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(typeid(T).name(), nullptr, nullptr, &status);
+    std::string name = (status == 0 && demangled != nullptr) ? demangled : typeid(T).name();
+    std::free(demangled);
+    return name;
+  }
+}
+
+// Rows of every per-type benchmark a family ran, keyed by candidate and type
+class TypedResults
+{
+public:
+  struct Cell
+  {
+    double runtime;         // ns
+    double speedup;
+    bool noisy;
+  };
+
+  const std::vector<std::string>& types() const { return types_; }
+  const std::vector<std::string>& candidates() const { return candidates_; }
+
+  // Row for a candidate/type pair, nullptr if the family has none
+  const Cell* find(const std::string& candidate, const std::string& type) const
+  {
+    auto row = cells_.find(candidate);
+    if (row == cells_.end()) { return nullptr; }
+    auto cell = row->second.find(type);
+    return (cell == row->second.end()) ? nullptr : &cell->second;
+  }
+
+private:
+  template<typename, typename, typename, typename>
+  friend class TypedFamily;
+
+  void begin_type(const std::string& type)
+  {
+    current_type_ = type;
+    types_.push_back(type);
+  }
+
+  // Records every row of a finished benchmark under the current type
+  template<typename Bench>
+  void collect(const Bench& bench)
+  {
+    for (const auto& row : bench.rows())
+    {
+      cells_[row.id][current_type_] = { row.runtime, row.speedup, row.noisy };
+      if (std::find(candidates_.begin(), candidates_.end(), row.id) == candidates_.end())
+      {
+        candidates_.push_back(row.id);
+      }
+    }
+  }
+
+  std::string current_type_;
+  std::vector<std::string> types_;
+  std::vector<std::string> candidates_;
+  std::unordered_map<std::string, std::unordered_map<std::string, Cell>> cells_;
+};
+
+// Return and argument types of a candidate, from the std::function it converts to
+template<typename Fn>
+struct CandidateSignature;
+
+template<typename R, typename... A>
+struct CandidateSignature<std::function<R(A...)>>
+{
+  using Return   = R;
+  using Function = std::function<R(A...)>;
+
+  template<typename Error>
+  using Bench = Benchmark<Error, R, A...>;
+};
+
+/*
+ * A benchmark family declared once over a list of element types
+ *
+ * Candidates are templates, so they're given as templated lambdas returning the candidate for
+ * one element type; `inputs` likewise returns the argument tuple for one type. run() builds a
+ * Benchmark per type from the baseline and inputs, inserts every candidate, runs it and
+ * print() shows a candidate x type matrix of runtime and speedup against each type's baseline.
+ * The error function is called with the return type of every instantiation, a generic lambda
+ * covers types whose return differs.
+ *
+ * Example:
+ * auto family = make_typed_family<TypeList<int32_t, int64_t, float, double>>("sort", sort_error,
+ *   []<typename T>() { return &std_sort_wrapper<T>; },
+ *   []<typename T>() { return std::make_tuple(random_vector<T>(4096)); },
+ *   100);
+ * family.insert([]<typename T>() { return &naive_selection_sort<T>; }, "Selection Sort");
+ * family.run();
+ * family.print();
+ */
+template<typename List, typename ErrorFn, typename Baseline, typename Inputs>
+class TypedFamily;
+
+template<typename... Ts, typename ErrorFn, typename Baseline, typename Inputs>
+class TypedFamily<TypeList<Ts...>, ErrorFn, Baseline, Inputs>
+{
+  template<typename T>
+  using Signature = CandidateSignature<decltype(std::function(std::declval<Baseline&>().template operator()<T>()))>;
+
+  template<typename T>
+  using Return = typename Signature<T>::Return;
+
+  template<typename T>
+  using Bench = typename Signature<T>::template Bench<std::decay_t<std::invoke_result_t<ErrorFn&, Return<T>, Return<T>>>>;
+
+  // Candidates instantiated for one type, in insertion order
+  template<typename T>
+  struct Candidates
+  {
+    std::vector<std::pair<typename Signature<T>::Function, std::string>> rows;
+  };
+
+public:
+  TypedFamily(const std::string& name, ErrorFn error, Baseline baseline, Inputs inputs, size_t iter) :
+    name_(name),
+    error_(error),
+    baseline_(baseline),
+    inputs_(inputs),
+    iter_(iter)
+  {}
+
+  // `candidate` is instantiated for every type in the list right away
+  template<typename Candidate>
+  void insert(Candidate candidate, const std::string& id)
+  {
+    (std::get<Candidates<Ts>>(candidates_).rows.emplace_back(candidate.template operator()<Ts>(), id), ...);
+  }
+
+  // Builds, runs and collects one benchmark per type, in list order
+  void run()
+  {
+    results_ = TypedResults();
+    (run_type<Ts>(), ...);
+  }
+
+  void print() const
+  {
+    const auto& types = results_.types();
+
+    std::cout << ">> " << name_ << " | " << types.size() << " types x " 
+              << results_.candidates().size() << " candidates (runtime / speedup)\n";
+    std::cout << std::left << std::setw(32) << "ID";
+    for (const auto& type : types) { std::cout << std::setw(28) << type; }
+    std::cout << '\n' << std::string(32 + 28 * types.size(), '-') << '\n';
+
+    for (const auto& candidate : results_.candidates())
+    {
+      std::cout << std::left << std::setw(32) << candidate;
+      for (const auto& type : types)
+      {
+        const TypedResults::Cell* row = results_.find(candidate, type);
+        std::ostringstream cell;
+        if (row != nullptr)
+        {
+          cell << BenchmarkRoot::format_runtime_string(row->runtime) << " / " 
+               << std::fixed << std::setprecision(3) << row->speedup << 'x'
+               << (row->noisy ? " !" : "");
+        }
+        else
+        {
+          cell << "-";
+        }
+        std::cout << std::setw(28) << cell.str();
+      }
+      std::cout << '\n';
+    }
+  }
+
+  const TypedResults& results() const { return results_; }
+
+private:
+  std::string name_;
+  ErrorFn error_;
+  Baseline baseline_;
+  Inputs inputs_;
+  size_t iter_;
+  std::tuple<Candidates<Ts>...> candidates_;
+  TypedResults results_;
+
+  template<typename T>
+  void run_type()
+  {
+    results_.begin_type(type_name<T>());
+
+    // Benchmarks measure their baseline on construction and aren't movable, keep it on the heap
+    auto bench = std::apply([&](auto&&... args)
+    {
+      return std::make_unique<Bench<T>>(error_, baseline_.template operator()<T>(), iter_, 
+                                        std::forward<decltype(args)>(args)...);
+    }, inputs_.template operator()<T>());
+    bench->set_name(name_ + "<" + type_name<T>() + ">");
+
+    for (const auto& [candidate, id] : std::get<Candidates<T>>(candidates_).rows)
+    {
+      bench->insert(candidate, id);
+    }
+    bench->run();
+    results_.collect(*bench);
+  }
+};
+
+// Deduces the lambda types so families can be declared inline
+template<typename List, typename ErrorFn, typename Baseline, typename Inputs>
+TypedFamily<List, ErrorFn, Baseline, Inputs> make_typed_family(const std::string& name, ErrorFn error, 
+                                                               Baseline baseline, Inputs inputs, size_t iter)
+{
+  return TypedFamily<List, ErrorFn, Baseline, Inputs>(name, error, baseline, inputs, iter);
+}
+
+#endif // BENCHMARK_TYPED_HPP
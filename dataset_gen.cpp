@@ -0,0 +1,132 @@
+#include "benchmark_dataset.hpp"
+
+// Writes a seeded binary dataset for benchmark_dataset.hpp's Dataset<T>
+// Usage: dataset_gen <path> --type=float --count=1000000000 [--seed=0] [--dist=uniform|normal]
+//                    [--min=0] [--max=1] [--mean=0] [--stddev=1] [--threads=N]
+// Uniform draws are in [min, max). Integer types default to their whole range (up to +/-2^53,
+// what a double holds exactly) and round down, so every integer in range is equally likely
+
+static void usage()
+{
+  std::cerr << "usage: dataset_gen <path> --type=<float|double|int32|int64|uint32|uint64> --count=<n>\n"
+            << "                   [--seed=<n>] [--dist=<uniform|normal>] [--min=<x>] [--max=<x>]\n"
+            << "                   [--mean=<x>] [--stddev=<x>] [--threads=<n>]\n";
+}
+
+// Digits only: std::stoull would take "-5" and wrap it around, or stop at "12abc"
+static uint64_t parse_unsigned(const std::string& value)
+{
+  if (value.empty() || !std::all_of(value.begin(), value.end(), [](unsigned char c) { return std::isdigit(c); }))
+  {
+    throw std::invalid_argument(value);
+  }
+  return std::stoull(value);
+}
+
+// [min, max) used when neither bound is given
+static std::pair<double, double> default_range(const std::string& type)
+{
+  if (type == "int32")  { return { -std::ldexp(1.0, 31), std::ldexp(1.0, 31) }; }
+  if (type == "int64")  { return { -std::ldexp(1.0, 53), std::ldexp(1.0, 53) }; }
+  if (type == "uint32") { return { 0.0, std::ldexp(1.0, 32) }; }
+  if (type == "uint64") { return { 0.0, std::ldexp(1.0, 53) }; }
+  return { 0.0, 1.0 };
+}
+
+template<typename T>
+static bool generate(const std::string& path, uint64_t count, uint64_t seed, const std::string& dist,
+                     double a, double b, unsigned threads)
+{
+  if (dist == "normal")
+  {
+    return write_dataset<T>(path, count, seed, [=](DatasetRng& rng) { return rng.normal(a, b); }, threads);
+  }
+  if constexpr (std::is_integral_v<T>)
+  {
+    return write_dataset<T>(path, count, seed, [=](DatasetRng& rng) { return std::floor(rng.uniform(a, b)); }, threads);
+  }
+  return write_dataset<T>(path, count, seed, [=](DatasetRng& rng) { return rng.uniform(a, b); }, threads);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 3)
+  {
+    usage();
+    return 1;
+  }
+
+  std::string path = argv[1], type, dist = "uniform";
+  uint64_t count = 0, seed = 0;
+  std::optional<double> min, max;
+  double mean = 0.0, stddev = 1.0;
+  unsigned threads = std::thread::hardware_concurrency();
+
+  for (int i = 2; i < argc; i++)
+  {
+    const std::string arg = argv[i];
+    const size_t eq = arg.find('=');
+    const std::string key = arg.substr(0, eq), value = (eq == std::string::npos) ? "" : arg.substr(eq + 1);
+
+    // Non-numeric or out of range values end up here
+    try
+    {
+      if (key == "--type")         { type = value; }
+      else if (key == "--count")   { count = parse_unsigned(value); }
+      else if (key == "--seed")    { seed = parse_unsigned(value); }
+      else if (key == "--dist")    { dist = value; }
+      else if (key == "--min")     { min = std::stod(value); }
+      else if (key == "--max")     { max = std::stod(value); }
+      else if (key == "--mean")    { mean = std::stod(value); }
+      else if (key == "--stddev")  { stddev = std::stod(value); }
+      else if (key == "--threads") { threads = static_cast<unsigned>(std::min<uint64_t>(parse_unsigned(value), std::numeric_limits<unsigned>::max())); }
+      else
+      {
+        usage();
+        return 1;
+      }
+    }
+    catch (const std::logic_error&)
+    {
+      std::cerr << "dataset_gen: bad value for " << key << ": '" << value << "'\n";
+      usage();
+      return 1;
+    }
+  }
+
+  if (count == 0 || (dist != "uniform" && dist != "normal"))
+  {
+    usage();
+    return 1;
+  }
+
+  const auto [low, high] = default_range(type);
+  const double a = (dist == "normal") ? mean : min.value_or(low);
+  const double b = (dist == "normal") ? stddev : max.value_or(high);
+  if (dist == "uniform" && !(a < b))
+  {
+    std::cerr << "dataset_gen: --min must be below --max\n";
+    return 1;
+  }
+
+  bool ok = false;
+  if (type == "float")       { ok = generate<float>(path, count, seed, dist, a, b, threads); }
+  else if (type == "double") { ok = generate<double>(path, count, seed, dist, a, b, threads); }
+  else if (type == "int32")  { ok = generate<int32_t>(path, count, seed, dist, a, b, threads); }
+  else if (type == "int64")  { ok = generate<int64_t>(path, count, seed, dist, a, b, threads); }
+  else if (type == "uint32") { ok = generate<uint32_t>(path, count, seed, dist, a, b, threads); }
+  else if (type == "uint64") { ok = generate<uint64_t>(path, count, seed, dist, a, b, threads); }
+  else
+  {
+    usage();
+    return 1;
+  }
+
+  if (!ok)
+  {
+    std::cerr << "dataset_gen: failed to write " << path << '\n';
+    return 1;
+  }
+  std::cout << "wrote " << count << ' ' << type << " (" << dist << ", seed " << seed << ") to " << path << '\n';
+  return 0;
+}
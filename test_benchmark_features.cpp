@@ -0,0 +1,1218 @@
+#include "benchmark.hpp"
+#include "benchmark_async.hpp"
+#include "benchmark_concurrent.hpp"
+#include "benchmark_dataset.hpp"
+#include "benchmark_tuner.hpp"
+#include "benchmark_typed.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <complex>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+// Behaviour checks for the harness features. Exits non-zero if any check fails
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& what)
+{
+  std::cout << (condition ? "  ok    " : "  FAIL  ") << what << '\n';
+  if (!condition) { failures++; }
+}
+
+static std::string temp_path(const std::string& name)
+{
+  const auto path = std::filesystem::temp_directory_path() / ("benchmark_features_" + name);
+  std::filesystem::remove_all(path);
+  return path.string();
+}
+
+static float float_error(float baseline, float result)
+{
+  return std::abs(baseline - result);
+}
+
+static double double_error(double baseline, double result)
+{
+  return std::abs(baseline - result);
+}
+
+static float vec_sum(std::vector<float> x)
+{
+  return std::accumulate(x.begin(), x.end(), 0.0f);
+}
+
+static float vec_max(std::vector<float> x)
+{
+  return *std::max_element(x.begin(), x.end());
+}
+
+static double vec_sum_double(std::vector<float> x)
+{
+  return std::accumulate(x.begin(), x.end(), 0.0);
+}
+
+// Suites sharing a binary and inputs keep their own rows, corrupt cache lines are skipped
+static void test_cache_key()
+{
+  std::cout << ">> cache key\n";
+  const std::string path = temp_path("cache.tsv");
+  {
+    std::ofstream corrupt(path);
+    corrupt << "zz\tgarbage\n" << "\t\n" << "123456789abcdef0123\t1\t2\n" << "12ab";
+  }
+  BenchmarkDefaults::cache_path = path;
+
+  const std::vector<float> input{ 3.0f, 1.0f, 4.0f, 1.0f, 5.0f };
+
+  Benchmark<float, float, std::vector<float>> first(float_error, vec_sum, 100, input);
+  first.set_name("first");
+  first.insert(vec_sum, "candidate");
+  first.run();
+  check(!first.find("candidate")->data_.cached, "first suite measures its candidate");
+
+  Benchmark<float, float, std::vector<float>> second(float_error, vec_max, 100, input);
+  second.set_name("second");
+  second.insert(vec_max, "candidate");
+  second.run();
+  check(!second.find("Baseline")->data_.cached, "another suite's baseline is not reused");
+  check(!second.find("candidate")->data_.cached, "another suite's candidate is not reused");
+  check(second.find("candidate")->result == 5.0f, "candidate keeps its own result");
+
+  Benchmark<float, float, std::vector<float>> again(float_error, vec_sum, 100, input);
+  again.set_name("first");
+  again.insert(vec_sum, "candidate");
+  again.run();
+  check(again.find("candidate")->data_.cached, "same suite, candidate and inputs hit");
+
+  Benchmark<double, double, std::vector<float>> retyped(double_error, vec_sum_double, 100, input);
+  retyped.set_name("first");
+  retyped.insert(vec_sum_double, "candidate");
+  retyped.run();
+  check(!retyped.find("candidate")->data_.cached, "different return type misses");
+
+  BenchmarkDefaults::cache_path.clear();
+  std::filesystem::remove(path);
+}
+
+static size_t counted_calls = 0;
+
+static float counted_sum(std::vector<float> x)
+{
+  counted_calls++;
+  return vec_sum(std::move(x));
+}
+
+// An interrupted run picks up partial samples, a finished row isn't measured again
+static void test_checkpoint_resume()
+{
+  std::cout << ">> checkpoint and resume\n";
+  const std::string path = temp_path("checkpoint.tsv");
+  const std::vector<float> input{ 2.0f, 7.0f, 1.0f, 8.0f };
+  NoisePolicy quiet;
+  quiet.enabled = false;
+
+  auto make = [&](const std::vector<float>& values, bool resume)
+  {
+    auto bench = std::make_unique<Benchmark<float, float, std::vector<float>>>(float_error, vec_sum, 10, values);
+    bench->set_name("resume");
+    bench->set_noise_policy(quiet);
+    bench->set_checkpoint(path, resume);
+    bench->insert(counted_sum, "candidate");
+    return bench;
+  };
+
+  // A finished run, cut back to three samples of the candidate as if it had been killed
+  make(input, false)->run();
+  {
+    std::ifstream in(path);
+    std::string line, partial;
+    while (std::getline(in, line))
+    {
+      if (line.rfind("samples\tresume\tcandidate\t", 0) != 0) { continue; }
+      std::istringstream fields(line);
+      std::string kind, suite, id, fingerprint;
+      std::getline(fields, kind, '\t');
+      std::getline(fields, suite, '\t');
+      std::getline(fields, id, '\t');
+      std::getline(fields, fingerprint, '\t');
+      partial = "samples\tresume\tcandidate\t" + fingerprint + "\t0\t11\t12\t13\n";
+    }
+    in.close();
+    std::ofstream out(path, std::ios::trunc);
+    out << partial;
+  }
+
+  counted_calls = 0;
+  {
+    auto interrupted = make(input, true);
+    interrupted->run();
+
+    const auto& samples = interrupted->find("candidate")->data_.samples;
+    check(samples.size() == 10, "resumed row has every iteration");
+    check(samples.size() >= 3 && samples[0] == 11.0 && samples[1] == 12.0 && samples[2] == 13.0,
+          "samples from the checkpoint are kept");
+    check(counted_calls >= 7 && counted_calls < 10, "only the missing iterations are measured");
+  }
+
+  counted_calls = 0;
+  {
+    auto resumed = make(input, true);
+    resumed->run();
+
+    check(counted_calls == 0, "finished row is restored without calling the candidate");
+    check(resumed->find("candidate")->result == 18.0f, "restored row keeps its result");
+    check(resumed->find("candidate")->data_.samples.size() == 10, "restored row keeps its samples");
+  }
+
+  // Same suite and id over other inputs must not pick up the old row
+  counted_calls = 0;
+  {
+    auto changed = make({ 1.0f, 1.0f }, true);
+    changed->run();
+
+    check(counted_calls >= 10 && changed->find("candidate")->result == 2.0f, "row from other inputs is measured again");
+    check(!changed->find("candidate")->data_.cached, "stale row isn't reported as restored");
+  }
+
+  std::filesystem::remove(path);
+}
+
+// Pages written by a call are copied back before the next one, whichever restore path ran
+static void test_dirty_pages()
+{
+  std::cout << ">> dirty page restore\n";
+  const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const size_t pages = 8;
+  std::vector<unsigned char> source(pages * page);
+  for (size_t i = 0; i < source.size(); i++) { source[i] = static_cast<unsigned char>(i * 7); }
+
+  DirtyPageRegion region(source.data(), source.size());
+  auto* working = static_cast<unsigned char*>(region.data());
+  auto matches = [&]() { return std::memcmp(working, source.data(), source.size()) == 0; };
+
+  // More than half dirty takes the bulk path
+  for (size_t p = 0; p < 5; p++) { working[p * page] ^= 0xff; }
+  region.restore();
+  check(region.last_dirty_pages() == 5, "bulk restore sees every dirtied page");
+  check(matches(), "bulk restore brings back the snapshot");
+
+  // A page the bulk copy wrote but no call did must still be tracked afterwards
+  working[7 * page + 1] ^= 0xff;
+  region.restore();
+  check(region.last_dirty_pages() == 1, "page untouched before a bulk restore is tracked after it");
+  check(matches(), "that page is restored");
+
+  working[2 * page] ^= 0xff;
+  working[3 * page] ^= 0xff;
+  region.restore();
+  check(region.last_dirty_pages() == 2 && matches(), "per page restore after a bulk one");
+}
+
+static int64_t int_error(int64_t baseline, int64_t result)
+{
+  return baseline - result;
+}
+
+// Increments most of the buffer, the restore afterwards goes through the bulk path
+static int64_t bump_most(int* x, size_t n)
+{
+  int64_t sum = 0;
+  for (size_t i = 0; i < n * 3 / 4; i++) { sum += ++x[i]; }
+  return sum;
+}
+
+// Increments only the last element, on a page the other candidate never writes
+static int64_t bump_last(int* x, size_t n)
+{
+  return ++x[n - 1];
+}
+
+static void test_dirty_pages_benchmark()
+{
+  std::cout << ">> dirty page restore in a benchmark\n";
+  const size_t n = 16 * static_cast<size_t>(sysconf(_SC_PAGESIZE)) / sizeof(int);
+  std::vector<int> buffer(n);
+  std::iota(buffer.begin(), buffer.end(), 0);
+
+  BenchmarkDefaults::restore = RestoreStrategy::DirtyPages;
+  Benchmark<int64_t, int64_t, int*, size_t> bench(int_error, bump_most, 50, buffer.data(), n);
+  bench.insert(bump_last, "last");
+  bench.run();
+  BenchmarkDefaults::restore = RestoreStrategy::DeepCopy;
+
+  int64_t expected = 0;
+  for (size_t i = 0; i < n * 3 / 4; i++) { expected += buffer[i] + 1; }
+  check(bench.find("Baseline")->result == expected, "every call sees the original buffer");
+  check(bench.find("last")->result == static_cast<int64_t>(n), "a page outside the bulk restore is restored too");
+  check(buffer[0] == 0 && buffer[n - 1] == static_cast<int>(n - 1), "caller's buffer is never written");
+}
+
+// Owns nothing expensive to build, but takes a while to destroy unless moved from
+struct SlowToDestroy
+{
+  bool owns{true};
+
+  SlowToDestroy() = default;
+  SlowToDestroy(const SlowToDestroy&) = default;
+  SlowToDestroy(SlowToDestroy&& other) noexcept : owns(other.owns) { other.owns = false; }
+  SlowToDestroy& operator=(const SlowToDestroy&) = default;
+
+  ~SlowToDestroy()
+  {
+    if (!owns) { return; }
+    const auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(200);
+    while (std::chrono::steady_clock::now() < until) {}
+  }
+};
+
+static int take_slow(SlowToDestroy slow)
+{
+  return slow.owns ? 1 : 0;
+}
+
+// Arguments moved into a candidate are destroyed after the timer stops
+static void test_argument_destruction()
+{
+  std::cout << ">> argument destruction\n";
+  auto error = [](int baseline, int result) { return baseline - result; };
+  Benchmark<int, int, SlowToDestroy> bench(error, take_slow, 20, SlowToDestroy());
+  bench.insert([](SlowToDestroy slow) { return slow.owns ? 1 : 0; }, "lambda");
+  bench.run();
+
+  check(bench.find("Baseline")->result == 1, "candidate gets an owning argument");
+  check(bench.find("Baseline")->data_.runtime < 100000.0, "destructor of a function's argument isn't timed");
+  check(bench.find("lambda")->data_.runtime < 100000.0, "destructor of a lambda's argument isn't timed");
+}
+
+static int64_t int_sum(std::vector<int> x)
+{
+  return std::accumulate(x.begin(), x.end(), int64_t(0));
+}
+
+// Drops the last element of inputs longer than three
+static int64_t int_sum_short(std::vector<int> x)
+{
+  return std::accumulate(x.begin(), x.end() - (x.size() > 3 ? 1 : 0), int64_t(0));
+}
+
+static std::tuple<std::vector<int>> int_input(uint64_t seed)
+{
+  std::mt19937_64 rng(seed);
+  std::vector<int> x(rng() % 8);
+  for (int& value : x) { value = 1 + static_cast<int>(rng() % 100); }
+  return {x};
+}
+
+// Failures are found from any thread, shrunk, and a missing magnitude is reported up front
+static void test_fuzz()
+{
+  std::cout << ">> fuzz\n";
+  Benchmark<int64_t, int64_t, std::vector<int>> exact(int_error, int_sum, 5, std::vector<int>{1, 2, 3});
+  exact.insert([](std::vector<int> x) { return int_sum(std::move(x)); }, "same");
+  check(exact.fuzz(int_input, 200, 0.0, 0, 2), "matching candidate passes");
+
+  Benchmark<int64_t, int64_t, std::vector<int>> bench(int_error, int_sum, 5, std::vector<int>{1, 2, 3});
+  bench.insert(int_sum_short, "short");
+  std::ostringstream report;
+  std::streambuf* const previous = std::cout.rdbuf(report.rdbuf());
+  const bool passed = bench.fuzz(int_input, 200, 0.0, 0, 2);
+  std::cout.rdbuf(previous);
+  check(!passed, "dropped element fails");
+  check(report.str().find("arg 0: 4 elements") != std::string::npos, "reproducer shrinks to the shortest failing input");
+
+  struct Pair { int64_t low, high; };
+  auto pair_error = [](int64_t baseline, int64_t result) { return Pair{baseline - result, 0}; };
+  Benchmark<Pair, int64_t, std::vector<int>> unsized(pair_error, int_sum, 5, std::vector<int>{1, 2, 3});
+  unsized.insert(int_sum_short, "short");
+  bool reported = false;
+  try { unsized.fuzz(int_input, 50, 0.0, 0, 2); } catch (const std::runtime_error&) { reported = true; }
+  check(reported, "Error without a magnitude throws before the workers start");
+
+  unsized.set_error_magnitude([](const Pair& error) { return std::abs(static_cast<double>(error.low)); });
+  std::cout.rdbuf(report.rdbuf());
+  const bool magnitude_passed = unsized.fuzz(int_input, 200, 0.0, 0, 2);
+  std::cout.rdbuf(previous);
+  check(!magnitude_passed, "custom magnitude is used");
+}
+
+// Inputs seen by each function, in call order. The candidates scribble over what they get
+static std::vector<std::vector<int>> seen_first, seen_second;
+
+static int record_first(std::vector<int> x)
+{
+  seen_first.push_back(x);
+  const int front = x.front();
+  std::fill(x.begin(), x.end(), 0);
+  return front;
+}
+
+static int record_second(std::vector<int> x)
+{
+  seen_second.push_back(x);
+  return x.front();
+}
+
+static int record_pointer(int* x, size_t n)
+{
+  seen_first.emplace_back(x, x + n);
+  const int front = x[0];
+  std::fill(x, x + n, 0);
+  return front;
+}
+
+// Timed calls rotate through shuffled inputs, results still come from the original ones
+static void test_input_variation()
+{
+  std::cout << ">> input variation\n";
+  std::vector<int> original(64);
+  std::iota(original.begin(), original.end(), 1);
+  auto error = [](int baseline, int result) { return baseline - result; };
+
+  Benchmark<int, int, std::vector<int>> bench(error, record_first, 40, original);
+  bench.set_input_variation(4, 7);
+  seen_first.clear();
+  bench.insert(record_second, "second");
+  bench.run();
+
+  std::vector<std::vector<int>> distinct = seen_second;
+  std::sort(distinct.begin(), distinct.end());
+  distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+  check(distinct.size() == 5, "four permutations plus the original input are seen");
+
+  bool permutations = true;
+  for (std::vector<int> input : seen_second)
+  {
+    std::sort(input.begin(), input.end());
+    permutations = permutations && input == original;
+  }
+  check(permutations, "every input is a restored permutation of the original");
+  check(bench.find("Baseline")->result == 1 && bench.find("second")->result == 1, "results come from the original input");
+
+  // The baseline re-measured on the same pool sees the same input at the same iteration. Noise
+  // re-runs are off so both rows get the same number of calls
+  NoisePolicy fixed;
+  fixed.enabled = false;
+  bench.set_noise_policy(fixed);
+  seen_first.clear();
+  seen_second.clear();
+  bench.set_input_variation(4, 7);
+  bench.run();
+  check(!seen_first.empty() && seen_first == seen_second, "rows see the same input per iteration");
+
+  seen_first.clear();
+  bench.set_input_variation(0);
+  check(std::all_of(seen_first.begin(), seen_first.end(), [&](const std::vector<int>& input) { return input == original; }),
+        "a pool size of 0 goes back to the original input");
+
+  // (pointer, count) arrays are shuffled and restored the same way
+  Benchmark<int, int, int*, size_t> pointers(error, record_pointer, 20, original.data(), original.size());
+  seen_first.clear();
+  pointers.set_input_variation(3, 11);
+  std::sort(seen_first.begin(), seen_first.end());
+  seen_first.erase(std::unique(seen_first.begin(), seen_first.end()), seen_first.end());
+  check(seen_first.size() == 4, "pointer inputs are varied too");
+  check(original.front() == 1 && original.back() == 64, "caller's array is never written");
+}
+
+// The calibrated overhead comes off the mean, samples stay as measured
+static void test_overhead_subtraction()
+{
+  std::cout << ">> overhead subtraction\n";
+  const std::vector<float> input(256, 1.0f);
+  const TimerBackend backend = Timer(BenchmarkDefaults::timer).backend();
+  const NoisePolicy noise = std::exchange(BenchmarkDefaults::noise, NoisePolicy{ .enabled = false });
+
+  // Far more than a call costs, per sample clamping would have flattened everything to zero
+  HarnessOverhead::set(ArgCategory::Container, backend, 1e6);
+  Benchmark<float, float, std::vector<float>> bench(float_error, vec_sum, 200, input);
+  bench.set_subtract_overhead(true);
+  const auto& clamped = bench.find("Baseline")->data_;
+  check(clamped.runtime == 0.0 && clamped.samples.front() > 0.0, "runtime clamps at zero, samples don't");
+
+  HarnessOverhead::set(ArgCategory::Container, backend, 1.0);
+  bench.set_subtract_overhead(true);
+  const auto& data = bench.find("Baseline")->data_;
+  const double mean = std::accumulate(data.samples.begin(), data.samples.end(), 0.0) / data.samples.size();
+  check(std::abs(data.runtime - (mean - 1.0)) < 1e-6 * mean, "runtime is the sample mean less the overhead");
+
+  BenchmarkDefaults::noise = noise;
+}
+
+// Sum of a mutable dataset view that zeroes what it read, so a stale restore shows up
+static double drain(std::span<float> x)
+{
+  double sum = 0.0;
+  for (float& value : x)
+  {
+    sum += value;
+    value = 0.0f;
+  }
+  return sum;
+}
+
+static double double_error_span(double baseline, double result)
+{
+  return baseline - result;
+}
+
+// Files are identical whatever the thread count and map back to what was generated
+static void test_dataset_round_trip()
+{
+  std::cout << ">> dataset round trip\n";
+  const std::string one = temp_path("dataset_1.bin"), many = temp_path("dataset_4.bin");
+  const uint64_t count = 3 * dataset_chunk + 17;
+  auto uniform = [](DatasetRng& rng) { return rng.uniform(-1.0, 1.0); };
+
+  check(write_dataset<float>(one, count, 42, uniform, 1), "single threaded write succeeds");
+  check(write_dataset<float>(many, count, 42, uniform, 4), "multi threaded write succeeds");
+  check(!write_dataset<float>(temp_path("missing") + "/dataset.bin", 16, 42, uniform), "write to a missing directory fails");
+
+  Dataset<float> first(one), second(many);
+  check(first.size() == count && first.seed() == 42, "header keeps count and seed");
+  check(std::memcmp(first.data(), second.data(), count * sizeof(float)) == 0, "contents don't depend on the thread count");
+
+  // Chunk zero replayed by hand
+  DatasetRng rng(DatasetRng(42).next());
+  bool replayed = true;
+  for (size_t i = 0; i < 1000; i++) { replayed = replayed && first.data()[i] == static_cast<float>(uniform(rng)); }
+  check(replayed, "elements match the seeded generator");
+
+  bool wrong_type = false;
+  try { Dataset<double> mismatched(one); } catch (const std::runtime_error&) { wrong_type = true; }
+  check(wrong_type, "loading as another element type throws");
+
+  std::filesystem::resize_file(many, dataset_data_offset + 8);
+  bool truncated = false;
+  try { Dataset<float> cut(many); } catch (const std::runtime_error&) { truncated = true; }
+  check(truncated, "truncated file throws");
+
+  // Mutable views restored through dirty pages, every call sees the file's contents
+  std::span<float> view = first.mutable_span();
+  const double expected = std::accumulate(first.data(), first.data() + count, 0.0);
+  BenchmarkDefaults::restore = RestoreStrategy::DirtyPages;
+  Benchmark<double, double, std::span<float>> bench(double_error_span, drain, 5, view);
+  bench.insert(drain, "again");
+  bench.run();
+  BenchmarkDefaults::restore = RestoreStrategy::DeepCopy;
+
+  check(bench.find("Baseline")->result == expected && bench.find("again")->result == expected,
+        "mutable view is restored before every call");
+  check(view[0] == first.data()[0], "harness never writes the caller's view");
+
+  std::filesystem::remove(one);
+  std::filesystem::remove(many);
+}
+
+// Only the TSC counts cycles, other timers leave them at zero instead of guessing
+static void test_cycles_by_timer()
+{
+  std::cout << ">> cycles by timer\n";
+  const TimerBackend timer = std::exchange(BenchmarkDefaults::timer, TimerBackend::Chrono);
+  Benchmark<float, float, std::vector<float>> bench(float_error, vec_sum, 20, std::vector<float>(64, 1.0f));
+  BenchmarkDefaults::timer = timer;
+  check(bench.find("Baseline")->data_.runtime > 0.0 && bench.find("Baseline")->data_.cycles == 0.0, 
+        "chrono timer reports no cycles");
+}
+
+static float sum_array(const float* x, size_t n)
+{
+  return std::accumulate(x, x + n, 0.0f);
+}
+
+// A (pointer, count) pair with no elements has nothing to repeat, sweep() refuses instead of looping
+static void test_sweep_empty_pointer()
+{
+  std::cout << ">> sweep on an empty array\n";
+  std::vector<float> data(1, 1.0f);
+  Benchmark<float, float, const float*, size_t> bench(float_error, sum_array, 5, data.data(), size_t(0));
+  check(!bench.sweep(1), "sweep with a zero element count returns false");
+}
+
+struct LockedQueue
+{
+  std::mutex mutex;
+  std::deque<size_t> items;
+};
+
+// 1p1c queue: both threads make progress, a starved thread doesn't skew the mix latencies and 
+// a throwing operation surfaces from run()
+static void test_concurrent_queue()
+{
+  std::cout << ">> concurrent 1p1c queue\n";
+  ConcurrentBenchmark<LockedQueue> bench([]() { return std::make_unique<LockedQueue>(); }, 
+                                         std::chrono::milliseconds(100), 64);
+  bench.add_role("producer", [](LockedQueue& queue, size_t thread)
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.items.push_back(thread);
+    return true;
+  });
+  bench.add_role("consumer", [](LockedQueue& queue, size_t)
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.items.empty()) { return false; }
+    queue.items.pop_front();
+    return true;
+  });
+  bench.add_role("sleeper", [](LockedQueue&, size_t)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    return true;
+  });
+  bench.add_mix("1p1c", {{"producer", 1}, {"consumer", 1}});
+  bench.add_mix("1p1s", {{"producer", 1}, {"sleeper", 1}});
+  bench.run();
+
+  const auto* queue = bench.find("1p1c");
+  check(queue != nullptr && queue->per_thread.size() == 2 && queue->ops_per_sec > 0.0, "1p1c mix completes ops");
+  check(queue != nullptr && queue->per_thread[0].ops > 0 && queue->per_thread[1].ops > 0, "producer and consumer both progress");
+
+  // Both threads keep 64 samples, the producer's stand for far more ops than the sleeper's
+  const auto* skewed = bench.find("1p1s");
+  check(skewed != nullptr && skewed->data_.runtime < skewed->per_thread[1].mean / 10.0, 
+        "mix mean is weighted by each thread's ops");
+
+  ConcurrentBenchmark<LockedQueue> failing([]() { return std::make_unique<LockedQueue>(); }, 
+                                           std::chrono::milliseconds(2000));
+  failing.add_role("thrower", [](LockedQueue&, size_t) -> bool { throw std::runtime_error("broken op"); });
+  failing.add_mix("broken", {{"thrower", 2}});
+  const auto began = std::chrono::steady_clock::now();
+  bool rethrown = false;
+  try { failing.run(); } catch (const std::runtime_error& error) { rethrown = std::string(error.what()) == "broken op"; }
+  check(rethrown, "operation exception is rethrown from run()");
+  check(std::chrono::steady_clock::now() - began < std::chrono::milliseconds(1000), "a throwing op ends the mix early");
+}
+
+static size_t alternate_calls = 0;
+
+// Alternates between about 1 us and 3 us of spinning, a spread no extra sample can fix
+static int alternating(int)
+{
+  const auto spin = std::chrono::nanoseconds((alternate_calls++ % 2) ? 3000 : 1000);
+  const auto until = std::chrono::steady_clock::now() + spin;
+  int spins = 0;
+  while (std::chrono::steady_clock::now() < until) { spins++; }
+  return spins > 0 ? 1 : 0;
+}
+
+// CV is flagged by default but only an imprecise mean is re-run
+static void test_noise_flags()
+{
+  std::cout << ">> noise flags\n";
+  NoisePolicy policy;
+  check(policy.max_cv > 0.0, "CV threshold is on by default");
+
+  policy.max_precision = 0.05;
+  const NoisePolicy previous = std::exchange(BenchmarkDefaults::noise, policy);
+  auto error = [](int baseline, int result) { return baseline - result; };
+  Benchmark<int, int, int> bench(error, alternating, 2000, 0);
+  BenchmarkDefaults::noise = previous;
+
+  const auto& data = bench.find("Baseline")->data_;
+  check(data.cv > 0.25 && data.noisy, "spread out row is flagged noisy");
+  check(data.precision <= 0.05 && data.samples.size() == 2000, "precise mean isn't re-run for its spread");
+}
+
+// Every row the table shows reaches the JSON stream, restored ones flagged cached, at full precision
+static void test_json_reporter()
+{
+  std::cout << ">> json lines reporter\n";
+  const std::string cache = temp_path("reporter_cache.tsv"), stream = temp_path("reporter.jsonl");
+  const std::vector<float> input(64, 1.0f);
+
+  auto measure = [&]()
+  {
+    BenchmarkDefaults::cache_path = cache;
+    BenchmarkDefaults::reporter = std::make_shared<JsonLinesReporter>(stream);
+    Benchmark<float, float, std::vector<float>> bench(float_error, vec_sum, 20, input);
+    bench.set_name("reporter");
+    bench.insert(vec_max, "max");
+    bench.run();
+    BenchmarkDefaults::cache_path.clear();
+    BenchmarkDefaults::reporter = nullptr;
+    return bench.find("max")->data_.runtime;
+  };
+  measure();
+  std::filesystem::remove(stream);
+  const double runtime = measure();
+
+  std::ifstream in(stream);
+  std::string line, finished;
+  size_t finishes = 0;
+  while (std::getline(in, line))
+  {
+    if (line.find("\"candidate_finish\"") == std::string::npos) { continue; }
+    finishes++;
+    if (line.find("\"id\":\"max\"") != std::string::npos) { finished = line; }
+  }
+  check(finishes == 2 && finished.find("\"cached\":true") != std::string::npos, "cached rows are reported, flagged cached");
+
+  const size_t at = finished.find("\"runtime_ns\":");
+  check(at != std::string::npos && std::stod(finished.substr(at + 13)) == runtime, "runtimes are written at full precision");
+
+  std::filesystem::remove(cache);
+  std::filesystem::remove(stream);
+}
+
+// Work shrinks as shift grows while the error grows with it, so the budget decides the winner
+static double shifted_double(const TuningConfig& config, double x)
+{
+  const long shift = config.at("shift");
+  volatile double sink = 0.0;
+  for (long i = 0; i < (8 - shift) * (8 - shift) * 100; i++) { sink = sink + 1.0; }
+  return x * 2.0 + static_cast<double>(shift) + sink * 0.0;
+}
+
+// Every strategy picks the fastest configuration within budget, misuse is rejected up front
+static void test_tuner_strategies()
+{
+  std::cout << ">> tuner strategies\n";
+  using DoubleTuner = Tuner<double, double, double>;
+  auto reference = [](double x) { return x * 2.0; };
+  DoubleTuner tuner(double_error, reference, shifted_double, 200, 1.5);
+  tuner.add_parameter("shift", 0, 7);
+  tuner.set_error_budget(2.5);
+
+  const TuningConfig grid = tuner.tune(DoubleTuner::Strategy::Grid);
+  check(tuner.evaluated() == 8 && grid.count("shift") && grid.at("shift") == 2, "grid measures everything, picks the fastest within budget");
+
+  tuner.tune(DoubleTuner::Strategy::Random, 3, 7);
+  check(tuner.evaluated() == 3, "random measures max_configs configurations");
+
+  const TuningConfig halving = tuner.tune(DoubleTuner::Strategy::SuccessiveHalving);
+  check(halving.count("shift") && halving.at("shift") == 2, "successive halving converges on the fastest within budget");
+
+  bool random_rejected = false, grid_rejected = false, budget_rejected = false;
+  try { tuner.tune(DoubleTuner::Strategy::Random); } catch (const std::invalid_argument&) { random_rejected = true; }
+  try { tuner.tune(DoubleTuner::Strategy::Grid, 3); } catch (const std::invalid_argument&) { grid_rejected = true; }
+  check(random_rejected && grid_rejected, "random needs a count, grid refuses one");
+
+  using Complex = std::complex<double>;
+  Tuner<Complex, double, double> complex_tuner(
+    [](double a, double b) { return Complex(a - b, 0.0); }, reference, shifted_double, 20, 1.5);
+  complex_tuner.add_parameter("shift", 0, 1);
+  complex_tuner.set_error_budget(1.0);
+  try { complex_tuner.tune(Tuner<Complex, double, double>::Strategy::Grid); } catch (const std::runtime_error&) { budget_rejected = true; }
+  check(budget_rejected, "a budget without an error magnitude is rejected");
+}
+
+template<typename T>
+static T typed_sum(std::vector<T> x)
+{
+  return std::accumulate(x.begin(), x.end(), T{});
+}
+
+template<typename T>
+static T typed_max(std::vector<T> x)
+{
+  return *std::max_element(x.begin(), x.end());
+}
+
+// A family over several types leaves a cell for every candidate and type
+static void test_typed_family()
+{
+  std::cout << ">> typed family\n";
+  auto family = make_typed_family<TypeList<int32_t, double>>("typed",
+    [](auto baseline, auto result) { return static_cast<double>(baseline) - static_cast<double>(result); },
+    []<typename T>() { return &typed_sum<T>; },
+    []<typename T>() { return std::make_tuple(std::vector<T>(64, T{1})); },
+    20);
+  family.insert([]<typename T>() { return &typed_sum<T>; }, "sum");
+  family.insert([]<typename T>() { return &typed_max<T>; }, "max");
+  family.run();
+
+  const TypedResults& results = family.results();
+  check(results.types() == std::vector<std::string>{ "int32", "double" }, "one column per type, in list order");
+
+  bool complete = true;
+  for (const std::string candidate : { "sum", "max" })
+  {
+    for (const std::string type : { "int32", "double" })
+    {
+      const TypedResults::Cell* cell = results.find(candidate, type);
+      complete = complete && cell != nullptr && cell->runtime > 0.0;
+    }
+  }
+  check(complete, "every candidate has a measured cell for every type");
+}
+
+template<int Work>
+static int spin_work(int x)
+{
+  volatile int sink = x;
+  for (int i = 0; i < Work; i++) { sink = sink + 1; }
+  return x;
+}
+
+// A clearly slower candidate stays significant after Holm's correction across every pair
+static void test_pair_comparisons()
+{
+  std::cout << ">> pair comparisons\n";
+  auto error = [](int baseline, int result) { return baseline - result; };
+  Benchmark<int, int, int> bench(error, spin_work<100>, 500, 1);
+  bench.insert(spin_work<100>, "same");
+  bench.insert(spin_work<5000>, "slow");
+  bench.run();
+
+  const std::vector<PairComparison> pairs = bench.compare(0.05);
+  check(pairs.size() == 3, "every pair of rows is compared");
+
+  const auto slow = std::find_if(pairs.begin(), pairs.end(),
+    [](const PairComparison& pair) { return pair.a == "Baseline" && pair.b == "slow"; });
+  check(slow != pairs.end() && slow->ratio < 1.0 && slow->ci_high < 1.0, "baseline is faster than the slow candidate, interval excludes 1");
+  check(slow != pairs.end() && slow->significant && slow->p_value < 0.05 / 3.0, "slow candidate is significant at the Holm-adjusted level");
+}
+
+// run_for() spends about its budget, or stops early once every row reaches the target precision
+static void test_run_for()
+{
+  std::cout << ">> run_for\n";
+  using clock = std::chrono::steady_clock;
+  auto error = [](int baseline, int result) { return baseline - result; };
+  {
+    Benchmark<int, int, int> bench(error, spin_work<100>, 10, 1);
+    bench.insert(spin_work<1000>, "slower");
+    const auto began = clock::now();
+    bench.run_for(std::chrono::milliseconds(200));
+    const double spent = std::chrono::duration<double>(clock::now() - began).count();
+    check(spent >= 0.2 && spent < 1.0, "whole budget is spent without badly overrunning it");
+    check(bench.find("Baseline")->data_.samples.size() + bench.find("slower")->data_.samples.size() > 20,
+          "rows are extended past their pilot");
+  }
+  {
+    Benchmark<int, int, int> bench(error, spin_work<100>, 10, 1);
+    bench.insert(spin_work<1000>, "slower");
+    const auto began = clock::now();
+    bench.run_for(std::chrono::seconds(30), 0.5);
+    const double spent = std::chrono::duration<double>(clock::now() - began).count();
+    check(spent < 5.0 && bench.find("slower")->data_.precision <= 0.5, "stops early once the target precision is met");
+  }
+}
+
+// Maps and touches 64 fresh pages every call, so each call takes minor faults
+static int fault_pages(int x)
+{
+  const size_t bytes = 64 * 4096;
+  void* pages = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (pages == MAP_FAILED) { return x; }
+  volatile char* bytes_ptr = static_cast<char*>(pages);
+  for (size_t offset = 0; offset < bytes; offset += 4096) { bytes_ptr[offset] = 1; }
+  munmap(pages, bytes);
+  return x;
+}
+
+// getrusage deltas are collected per timed call and pin the faults on the row that took them
+static void test_resource_usage()
+{
+  std::cout << ">> resource usage\n";
+  auto error = [](int baseline, int result) { return baseline - result; };
+  const bool previous = std::exchange(BenchmarkDefaults::resource_usage, true);
+  Benchmark<int, int, int> bench(error, spin_work<100>, 200, 1);
+  BenchmarkDefaults::resource_usage = previous;
+  bench.insert(fault_pages, "faults");
+  bench.run();
+
+  const auto& faulting = bench.find("faults")->data_;
+  const auto& quiet    = bench.find("Baseline")->data_;
+  check(faulting.usage.calls == faulting.samples.size(), "one getrusage delta per timed call");
+  check(faulting.usage.per_call(faulting.usage.minor_faults) >= 32.0, "faulting row sees its minor faults");
+  check(quiet.usage.per_call(quiet.usage.minor_faults) < 1.0, "quiet row doesn't");
+
+  Benchmark<int, int, int> off(error, spin_work<100>, 20, 1);
+  check(off.find("Baseline")->data_.usage.calls == 0, "nothing is collected unless enabled");
+}
+
+// SIGPROF samples taken inside the timed calls end up in a folded stack file per row
+static void test_profiler()
+{
+  std::cout << ">> sampling profiler\n";
+  const std::string dir = temp_path("profile");
+  auto error = [](int baseline, int result) { return baseline - result; };
+  Benchmark<int, int, int> bench(error, spin_work<100>, 400, 1);
+  bench.set_name("profiled");
+  bench.set_profiler(dir);
+  bench.insert(spin_work<200000>, "busy");
+  bench.run();
+  bench.set_profiler("");
+
+  std::ifstream in(dir + "/profiled.busy.folded");
+  std::string line;
+  size_t stacks = 0, samples = 0;
+  bool well_formed = true;
+  while (std::getline(in, line))
+  {
+    const size_t space = line.rfind(' ');
+    well_formed = well_formed && space != std::string::npos && space != 0;
+    if (space == std::string::npos) { continue; }
+    stacks++;
+    samples += std::stoul(line.substr(space + 1));
+  }
+  check(stacks > 0 && well_formed, "busy row gets a folded stack file");
+  check(samples > 0, "samples are taken while the candidate runs");
+  check(!std::filesystem::exists(dir + "/profiled.Baseline.folded"), "rows measured before set_profiler() aren't profiled");
+  std::filesystem::remove_all(dir);
+}
+
+// Just enough of a JSON parser to validate a document and collect the "name" of every object
+struct JsonScan
+{
+  const std::string& text;
+  size_t at{0};
+  std::vector<std::string> names;
+
+  void space() { while (at < text.size() && std::isspace(static_cast<unsigned char>(text[at]))) { at++; } }
+  bool eat(char c) { space(); if (at < text.size() && text[at] == c) { at++; return true; } return false; }
+
+  bool string(std::string& out)
+  {
+    if (!eat('"')) { return false; }
+    while (at < text.size() && text[at] != '"')
+    {
+      if (text[at] == '\\') { at++; }
+      if (at < text.size()) { out += text[at++]; }
+    }
+    return eat('"');
+  }
+
+  bool value()
+  {
+    space();
+    if (at >= text.size()) { return false; }
+    std::string ignored;
+    switch (text[at])
+    {
+      case '{':
+      {
+        at++;
+        if (eat('}')) { return true; }
+        do
+        {
+          std::string key;
+          if (!string(key) || !eat(':')) { return false; }
+          space();
+          if (key == "name" && at < text.size() && text[at] == '"')
+          {
+            std::string name;
+            if (!string(name)) { return false; }
+            names.push_back(name);
+          }
+          else if (!value()) { return false; }
+        } while (eat(','));
+        return eat('}');
+      }
+      case '[':
+        at++;
+        if (eat(']')) { return true; }
+        do { if (!value()) { return false; } } while (eat(','));
+        return eat(']');
+      case '"':
+        return string(ignored);
+      default:
+      {
+        for (const char* word : { "true", "false", "null" })
+        {
+          if (text.compare(at, std::strlen(word), word) == 0) { at += std::strlen(word); return true; }
+        }
+        char* end = nullptr;
+        std::strtod(text.c_str() + at, &end);
+        if (end == text.c_str() + at) { return false; }
+        at = static_cast<size_t>(end - text.c_str());
+        return true;
+      }
+    }
+  }
+
+  bool document() { const bool ok = value(); space(); return ok && at == text.size(); }
+};
+
+// The Chrome trace export is valid JSON with the harness phases recorded as events
+static void test_trace_export()
+{
+  std::cout << ">> trace export\n";
+  const std::string path = temp_path("trace.json");
+  TraceRecorder::clear();
+  TraceRecorder::enable();
+  {
+    auto error = [](int baseline, int result) { return baseline - result; };
+    Benchmark<int, int, int> bench(error, spin_work<100>, 20, 1);
+    bench.insert(spin_work<200>, "traced \"quoted\"");
+    bench.run();
+  }
+  TraceRecorder::disable();
+  check(TraceRecorder::write_chrome_trace(path), "trace is written");
+
+  std::ifstream in(path);
+  const std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  JsonScan scan{ text, 0, {} };
+  check(scan.document(), "trace parses as JSON");
+  check(std::find(scan.names.begin(), scan.names.end(), "measure") != scan.names.end(), "a measure event is recorded");
+  check(std::find(scan.names.begin(), scan.names.end(), "traced \"quoted\"") != scan.names.end(), "candidate ids are escaped");
+
+  TraceRecorder::clear();
+  std::filesystem::remove(path);
+}
+
+static int capture_calls = 0;
+
+static int count_calls(int)
+{
+  return ++capture_calls;
+}
+
+// KeepLast keeps the final call's result, KeepFirst an earlier one, Discard none
+static void test_result_capture()
+{
+  std::cout << ">> result capture\n";
+  auto error = [](int baseline, int result) { return baseline - result; };
+  auto captured = [&](ResultCapture capture)
+  {
+    Benchmark<int, int, int> bench(error, spin_work<10>, 50, 1);
+    bench.set_result_capture(capture);
+    bench.insert(count_calls, "counter");
+    capture_calls = 0;
+    bench.run();
+    return bench.find("counter")->result;
+  };
+
+  const int last = captured(ResultCapture::KeepLast);
+  check(last == capture_calls && capture_calls >= 50, "KeepLast returns the last call's value");
+  const int first = captured(ResultCapture::KeepFirst);
+  check(first >= 1 && first < capture_calls, "KeepFirst returns an earlier call's value");
+  check(captured(ResultCapture::Discard) == 0, "Discard leaves the default value");
+}
+
+static std::vector<size_t> placement_offsets;
+
+// Records where the harness placed its copy of the array relative to a cache line
+static float placed_sum(float* x, size_t n)
+{
+  placement_offsets.push_back(reinterpret_cast<uintptr_t>(x) % 64);
+  return std::accumulate(x, x + n, 0.0f);
+}
+
+// Every (function, policy) pair gets its own row and the copies land where the policy says
+static void test_allocation_variants()
+{
+  std::cout << ">> allocation variants\n";
+  std::vector<float> input(256, 1.0f);
+  Benchmark<float, float, float*, size_t> bench(float_error, placed_sum, 20, input.data(), input.size());
+  bench.insert(placed_sum, "placed");
+  bench.run();
+
+  const std::vector<AllocationPolicy> policies = { {}, { 64, 0 }, { 64, 4 } };
+  std::ostringstream table;
+  std::streambuf* previous = std::cout.rdbuf(table.rdbuf());
+  placement_offsets.clear();
+  const bool ran = bench.allocation_variants(policies, 10);
+  std::cout.rdbuf(previous);
+
+  size_t rows = 0;
+  for (const std::string id : { "Baseline", "placed" })
+  {
+    for (const auto& policy : policies)
+    {
+      rows += table.str().find(id + " [" + policy.name() + "]") != std::string::npos;
+    }
+  }
+  check(ran && rows == 6, "one row per function and policy");
+  check(std::count(placement_offsets.begin(), placement_offsets.end(), size_t(4)) >= 20, "offset policy places copies 4 bytes past a cache line");
+}
+
+static float first_element(float* x, size_t)
+{
+  return x[0];
+}
+
+// Restores are timed apart from the calls and flagged when they cost more than the call
+static void test_restore_report()
+{
+  std::cout << ">> restore time report\n";
+  std::vector<float> input(1 << 20, 1.0f);
+  Benchmark<float, float, float*, size_t> bench(float_error, first_element, 20, input.data(), input.size());
+  bench.set_name("restores");
+  bench.insert(first_element, "peek");
+  bench.run();
+
+  std::ostringstream table;
+  std::streambuf* previous = std::cout.rdbuf(table.rdbuf());
+  bench.print();
+  std::cout.rdbuf(previous);
+
+  const auto& peek = bench.find("peek")->data_;
+  check(peek.restore > 0.0 && peek.restore > peek.runtime, "restoring 4 MB costs more than reading one element");
+  check(table.str().find("Restore") != std::string::npos, "table shows a Restore column");
+  check(table.str().find("harness: ") != std::string::npos, "harness time is broken down");
+  check(table.str().find("! restoring arguments costs more than the calls for Baseline, peek") != std::string::npos,
+        "dominated rows are named");
+}
+
+// Regions over a dataset's mutable view restore from the file, not from a copy of their own
+static void test_file_backed_dirty_pages()
+{
+  std::cout << ">> file backed dirty pages\n";
+  const std::string path = temp_path("dataset_dirty.bin");
+  const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const uint64_t count = 8 * page / sizeof(float);
+  write_dataset<float>(path, count, 7, [](DatasetRng& rng) { return rng.uniform(0.0, 1.0); }, 1);
+
+  Dataset<float> dataset(path);
+  std::span<float> view = dataset.mutable_span();
+  {
+    // Starts mid page so the mapping has to lead in from the page boundary
+    const std::span<float> part = view.subspan(3);
+    DirtyPageRegion region(part.data(), part.size_bytes());
+    auto* working = static_cast<float*>(region.data());
+    auto matches = [&]() { return std::memcmp(working, dataset.data() + 3, part.size_bytes()) == 0; };
+    check(region.file_backed() && matches(), "view is mapped from the file");
+
+    const size_t per_page = page / sizeof(float);
+    for (size_t p = 0; p < 6; p++) { working[p * per_page] += 1.0f; }
+    region.restore();
+    check(region.last_dirty_pages() == 6 && matches(), "bulk restore remaps the file");
+
+    working[0] += 1.0f;
+    working[part.size() - 1] += 1.0f;
+    region.restore();
+    check(region.last_dirty_pages() == 2 && matches(), "per page restore copies from the read-only mapping");
+  }
+
+  std::vector<float> heap(view.begin(), view.end());
+  DirtyPageRegion copied(heap.data(), heap.size() * sizeof(float));
+  check(!copied.file_backed(), "unregistered memory keeps its own snapshot");
+  std::filesystem::remove(path);
+}
+
+// Odd sysfs cache sizes are rejected instead of throwing or being misread
+static void test_cache_size_parsing()
+{
+  std::cout << ">> cache size parsing\n";
+  check(parse_cache_size("48K") == size_t(48) << 10 && parse_cache_size("32M") == size_t(32) << 20
+        && parse_cache_size("4096") == size_t(4096), "sysfs sizes parse");
+  check(!parse_cache_size("") && !parse_cache_size("unknown") && !parse_cache_size("-1K")
+        && !parse_cache_size("12Q") && !parse_cache_size("99999999999999999999K"), "malformed sizes are skipped");
+  check(!cache_levels().empty() && cache_levels().back().bytes > 0, "some cache hierarchy is always available");
+}
+
+static std::atomic<int> async_in_flight{0};
+static std::atomic<int> async_most_in_flight{0};
+
+// Sleeps briefly on its own thread so several operations overlap
+static std::future<int> async_double(int x)
+{
+  return std::async(std::launch::async, [x]()
+  {
+    const int now = ++async_in_flight;
+    int seen = async_most_in_flight.load();
+    while (now > seen && !async_most_in_flight.compare_exchange_weak(seen, now)) {}
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+    async_in_flight--;
+    return x * 2;
+  });
+}
+
+// Suspends the eager task and resumes it on a fresh thread
+struct ResumeElsewhere
+{
+  bool await_ready() { return false; }
+  void await_suspend(std::coroutine_handle<> handle) { std::thread([handle]() { handle.resume(); }).detach(); }
+  void await_resume() {}
+};
+
+static EagerTask<int> eager_double(int x)
+{
+  co_await ResumeElsewhere{};
+  co_return x * 2;
+}
+
+// Futures and eager tasks are timed to completion with several operations in flight
+static void test_async_benchmark()
+{
+  std::cout << ">> async benchmark\n";
+  auto error = [](int baseline, int result) { return baseline - result; };
+
+  Benchmark<int, std::future<int>, int> futures(error, async_double, 40, 4, 21);
+  futures.insert(async_double, "again");
+  futures.run();
+  const auto& again = *futures.find("again");
+  check(again.result == 42 && again.error == 0 && again.data_.samples.size() == 40, "futures are awaited, every completion sampled");
+  check(async_most_in_flight.load() >= 2, "operations overlap with concurrency 4");
+  check(again.data_.runtime >= 200e3, "latency covers the operation, not just submission");
+
+  Benchmark<int, EagerTask<int>, int> tasks(error, eager_double, 40, 4, 21);
+  tasks.insert(eager_double, "eager");
+  tasks.run();
+  check(tasks.find("eager")->result == 42 && tasks.find("eager")->data_.samples.size() == 40, "eager tasks complete through Completion");
+}
+
+// Calibration runs on plain settings and hands back every default it swapped out
+static void test_calibration_defaults()
+{
+  std::cout << ">> calibration defaults\n";
+  NoisePolicy strict;
+  strict.max_precision = 0.001;
+  BenchmarkDefaults::restore        = RestoreStrategy::DirtyPages;
+  BenchmarkDefaults::allocation     = { 64, 4 };
+  BenchmarkDefaults::capture        = ResultCapture::Discard;
+  BenchmarkDefaults::resource_usage = true;
+  const NoisePolicy previous = std::exchange(BenchmarkDefaults::noise, strict);
+
+  calibrate_harness<float>(200, false);
+
+  check(HarnessOverhead::get(ArgCategory::PointerSize, BenchmarkDefaults::timer).has_value(), "overhead is calibrated");
+  check(BenchmarkDefaults::restore == RestoreStrategy::DirtyPages && BenchmarkDefaults::allocation.offset == 4
+        && BenchmarkDefaults::capture == ResultCapture::Discard && BenchmarkDefaults::resource_usage
+        && BenchmarkDefaults::noise.max_precision == 0.001, "every swapped default is put back");
+
+  BenchmarkDefaults::restore        = RestoreStrategy::DeepCopy;
+  BenchmarkDefaults::allocation     = {};
+  BenchmarkDefaults::capture        = ResultCapture::KeepLast;
+  BenchmarkDefaults::resource_usage = false;
+  BenchmarkDefaults::noise          = previous;
+}
+
+int main()
+{
+  test_cache_key();
+  test_checkpoint_resume();
+  test_dirty_pages();
+  test_dirty_pages_benchmark();
+  test_argument_destruction();
+  test_dataset_round_trip();
+  test_fuzz();
+  test_input_variation();
+  test_overhead_subtraction();
+  test_cycles_by_timer();
+  test_sweep_empty_pointer();
+  test_concurrent_queue();
+  test_noise_flags();
+  test_json_reporter();
+  test_tuner_strategies();
+  test_typed_family();
+  test_pair_comparisons();
+  test_run_for();
+  test_resource_usage();
+  test_profiler();
+  test_trace_export();
+  test_result_capture();
+  test_allocation_variants();
+  test_restore_report();
+  test_file_backed_dirty_pages();
+  test_cache_size_parsing();
+  test_async_benchmark();
+  test_calibration_defaults();
+
+  std::cout << (failures == 0 ? "All checks passed\n" : std::to_string(failures) + " check(s) failed\n");
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}